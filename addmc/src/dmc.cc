@@ -15,10 +15,22 @@ Int dotFileIndex = 1;
 string planningStrategy;
 Int threadCount;
 Int threadSliceCount;
+Float sliceSecondsBudget;
+Int sliceNodesBudget;
+Int subtreeThreadCount;
+string spillDir;
+Int localSearchThreadCount;
+string checkpointDir;
+Float checkpointSeconds;
+Float deadlineSeconds;
+bool maximizerSolving;
 string ddPackage;
 Float memSensitivity;
 Float maxMem;
 string joinPriority;
+string reorderingMethod;
+Float reorderingGrowth;
+Float reorderingSecondsBudget;
 Int verboseJoinTree;
 Int verboseProfiling;
 #define COUNT
@@ -431,6 +443,11 @@ Dd::Dd(const Dd& dd) {
   else {
     this->mtbdd = dd.mtbdd;
   }
+  this->nodeCount = dd.nodeCount;
+  this->leafCount = dd.leafCount;
+  this->minValue = dd.minValue;
+  this->maxValue = dd.maxValue;
+  this->support = dd.support;
 }
 
 const Cudd* Dd::newMgr(Float mem, Int threadIndex) {
@@ -453,6 +470,11 @@ const Cudd* Dd::newMgr(Float mem, Int threadIndex) {
   return mgr;
 }
 
+void Dd::recycleMgr(const Cudd* mgr) {
+  assert(ddPackage == CUDD);
+  cuddGarbageCollect(mgr->getManager(), 1); // also clears cache entries of dead nodes
+}
+
 Dd Dd::getConstDd(const Number& n, const Cudd* mgr) {
   if (ddPackage == CUDD) {
     return logCounting ? Dd(mgr->constant(n.getLog10())) : Dd(mgr->constant(n.fraction));
@@ -468,6 +490,13 @@ Dd Dd::getConstDd(const Number& n, const Cudd* mgr) {
   return Dd(Mtbdd::doubleTerminal(n.fraction));
 }
 
+Dd Dd::getIntDd(Int n, const Cudd* mgr) {
+  if (ddPackage == CUDD) {
+    return Dd(mgr->constant(n));
+  }
+  return getConstDd(multiplePrecision ? Number(mpq_class(static_cast<long>(n))) : Number(static_cast<Float>(n)), mgr); // logCounting is not used with Sylvan
+}
+
 Dd Dd::getZeroDd(const Cudd* mgr) {
   return getConstDd(Number(), mgr);
 }
@@ -490,10 +519,10 @@ Dd Dd::getVarDd(Int ddVar, bool val, const Cudd* mgr) {
 }
 
 size_t Dd::countNodes() const {
-  if (ddPackage == CUDD) {
-    return cuadd.nodeCount();
+  if (nodeCount < 0) {
+    nodeCount = ddPackage == CUDD ? cuadd.nodeCount() : mtbdd.NodeCount();
   }
-  return mtbdd.NodeCount();
+  return nodeCount;
 }
 
 bool Dd::operator<(const Dd& rightDd) const {
@@ -518,13 +547,23 @@ Number Dd::extractConst() const {
   return Number(mtbdd_getdouble(mtbdd.GetMTBDD()));
 }
 
-Dd Dd::getComposition(Int ddVar, bool val, const Cudd* mgr) const {
+Dd Dd::getNodeDd(Int ddVar, const Dd& thenDd, const Dd& elseDd, const Cudd* mgr) {
   if (ddPackage == CUDD) {
-    if (util::isFound(ddVar, cuadd.SupportIndices())) {
-      Dd ans = Dd(cuadd.Compose(val ? mgr->addOne() : mgr->addZero(), ddVar));
-      return ans;
+    if (thenDd.cuadd == elseDd.cuadd) {
+      return thenDd;
+    }
+    DdNode* node = cuddUniqueInter(mgr->getManager(), ddVar, thenDd.cuadd.getNode(), elseDd.cuadd.getNode());
+    if (node == NULL) {
+      throw MyError("node construction failed | CUDD error code ", Cudd_ReadErrorCode(mgr->getManager()));
     }
-    return *this;
+    return Dd(ADD(*mgr, node));
+  }
+  return Dd(mtbdd_makenode(ddVar, elseDd.mtbdd.GetMTBDD(), thenDd.mtbdd.GetMTBDD())); // (var, lo, hi); reduces equal children
+}
+
+Dd Dd::getComposition(Int ddVar, bool val, const Cudd* mgr) const {
+  if (ddPackage == CUDD) { // Compose stops below the level of ddVar, so no support scan is needed
+    return Dd(cuadd.Compose(val ? mgr->addOne() : mgr->addZero(), ddVar));
   }
   sylvan::MtbddMap m;
   m.put(ddVar, val ? Mtbdd::mtbddOne() : Mtbdd::mtbddZero());
@@ -532,6 +571,39 @@ Dd Dd::getComposition(Int ddVar, bool val, const Cudd* mgr) const {
   return ans;
 }
 
+ADD Dd::getTransferredNode(DdNode* node, const Cudd* destMgr, Map<DdNode*, ADD>& transferredNodes) {
+  auto it = transferredNodes.find(node);
+  if (it != transferredNodes.end()) {
+    return it->second;
+  }
+  ADD transferredNode = cuddIsConstant(node) ? destMgr->constant(cuddV(node)) : destMgr->addVar(node->index).Ite(
+    getTransferredNode(cuddT(node), destMgr, transferredNodes),
+    getTransferredNode(cuddE(node), destMgr, transferredNodes)
+  ); // Ite keeps the result ordered even if destMgr has reordered vars
+  transferredNodes.insert({node, transferredNode});
+  return transferredNode;
+}
+
+Dd Dd::getComplement(const Cudd* mgr) const {
+  if (ddPackage == CUDD) {
+    return Dd(cuadd.Cmpl());
+  }
+  return getOneDd(mgr).getSubtraction(*this);
+}
+
+Dd Dd::getIte(const Dd& thenDd, const Dd& elseDd, const Cudd* mgr) const {
+  if (ddPackage == CUDD) {
+    return Dd(cuadd.Ite(thenDd.cuadd, elseDd.cuadd));
+  }
+  return getProduct(thenDd).getSum(getComplement(mgr).getProduct(elseDd)); // Sylvan's ite needs a BDD condition
+}
+
+Dd Dd::getTransfer(const Cudd* destMgr) const {
+  assert(ddPackage == CUDD);
+  Map<DdNode*, ADD> transferredNodes; // node in source manager |-> ADD in destMgr
+  return Dd(getTransferredNode(cuadd.getNode(), destMgr, transferredNodes));
+}
+
 Dd Dd::getProduct(const Dd& dd) const {
   if (ddPackage == CUDD) {
     return logCounting ? Dd(cuadd + dd.cuadd) : Dd(cuadd * dd.cuadd);
@@ -552,8 +624,271 @@ Dd Dd::getThreshold(Int threshold, const Cudd* mgr) const {
     ADD th = mgr->constant(threshold);
     return cuadd.Threshold_DPMS(th);
   }
-  std::cout<<"threshold not implemented for packages other than CUDD!";
-  exit(1);
+  return getMin(getIntDd(threshold, mgr)); // saturates terminals above threshold
+}
+
+DdNode* Dd::getBoundedSumNode(DdManager* manager, DdNode* f, DdNode* g, DdNode* bound) {
+  statLine(manager);
+  if (cuddIsConstant(f) && cuddIsConstant(g)) {
+    return cuddUniqueConst(manager, min(cuddV(f) + cuddV(g), cuddV(bound)));
+  }
+  if ((cuddIsConstant(f) && cuddV(f) >= cuddV(bound)) || (cuddIsConstant(g) && cuddV(g) >= cuddV(bound))) { // costs are non-negative
+    return bound;
+  }
+  if (f > g) { // plus is commutative, so normalizes cache key
+    std::swap(f, g);
+  }
+  DdNode* res = cuddCacheLookup(manager, DD_ADD_BOUNDED_PLUS_TAG, f, g, bound);
+  if (res != NULL) {
+    return res;
+  }
+  checkWhetherToGiveUp(manager);
+
+  int fLevel = cuddI(manager, f->index);
+  int gLevel = cuddI(manager, g->index);
+  DdHalfWord index = fLevel <= gLevel ? f->index : g->index;
+  DdNode* fThen = fLevel <= gLevel ? cuddT(f) : f;
+  DdNode* fElse = fLevel <= gLevel ? cuddE(f) : f;
+  DdNode* gThen = gLevel <= fLevel ? cuddT(g) : g;
+  DdNode* gElse = gLevel <= fLevel ? cuddE(g) : g;
+
+  DdNode* T = getBoundedSumNode(manager, fThen, gThen, bound);
+  if (T == NULL) {
+    return NULL;
+  }
+  cuddRef(T);
+  DdNode* E = getBoundedSumNode(manager, fElse, gElse, bound);
+  if (E == NULL) {
+    Cudd_RecursiveDeref(manager, T);
+    return NULL;
+  }
+  cuddRef(E);
+  res = T == E ? T : cuddUniqueInter(manager, index, T, E);
+  if (res == NULL) {
+    Cudd_RecursiveDeref(manager, T);
+    Cudd_RecursiveDeref(manager, E);
+    return NULL;
+  }
+  cuddDeref(T);
+  cuddDeref(E);
+  cuddCacheInsert(manager, DD_ADD_BOUNDED_PLUS_TAG, f, g, bound, res);
+  return res;
+}
+
+Dd Dd::getBoundedSum(const Dd& dd, Int bound, const Cudd* mgr) const {
+#ifdef NOTHRESHOLD
+  return getSum(dd);
+#endif
+  if (ddPackage == SYLVAN) {
+    return getSum(dd).getThreshold(bound, mgr);
+  }
+  DdManager* manager = mgr->getManager();
+  ADD boundAdd = mgr->constant(bound); // keeps bound node alive during recursion
+  DdNode* res;
+  do { // same retry loop as Cudd_addApply
+    manager->reordered = 0;
+    res = getBoundedSumNode(manager, cuadd.getNode(), dd.cuadd.getNode(), boundAdd.getNode());
+  } while (manager->reordered == 1);
+  if (res == NULL) {
+    throw MyError("bounded sum failed | CUDD error code ", Cudd_ReadErrorCode(manager));
+  }
+  return Dd(ADD(*mgr, res));
+}
+
+vector<Float> Dd::ddVarNegativeWeights;
+vector<Float> Dd::ddVarPositiveWeights;
+vector<bool> Dd::ddVarAdditivity;
+
+void Dd::setAbstractionWeights(const vector<Int>& ddVarToCnfVarMap) {
+  ddVarNegativeWeights.clear();
+  ddVarPositiveWeights.clear();
+  ddVarAdditivity.clear();
+  for (Int cnfVar : ddVarToCnfVarMap) {
+    ddVarNegativeWeights.push_back(JoinNode::cnf.literalWeights.at(-cnfVar).fraction);
+    ddVarPositiveWeights.push_back(JoinNode::cnf.literalWeights.at(cnfVar).fraction);
+    ddVarAdditivity.push_back(JoinNode::cnf.additiveVars.contains(cnfVar));
+  }
+}
+
+ADD Dd::getCubeAdd(const vector<Int>& ddVars, Float leaf, const Cudd* mgr) {
+  vector<Int> sortedDdVars = ddVars;
+  std::sort(sortedDdVars.begin(), sortedDdVars.end(), [&](Int a, Int b) {
+    return mgr->ReadPerm(a) > mgr->ReadPerm(b);
+  }); // bottom var first
+  ADD cube = mgr->constant(leaf);
+  for (Int ddVar : sortedDdVars) {
+    cube = mgr->addVar(ddVar).Ite(cube, mgr->addZero());
+  }
+  return cube;
+}
+
+DdNode* Dd::getWeightedNode(DdManager* manager, DdNode* node, Float weight) {
+  if (weight == 1) {
+    return node;
+  }
+  DdNode* weightNode = cuddUniqueConst(manager, weight);
+  if (weightNode == NULL) {
+    return NULL;
+  }
+  cuddRef(weightNode);
+  DdNode* res = cuddAddApplyRecur(manager, Cudd_addTimes, node, weightNode);
+  if (res == NULL) {
+    Cudd_RecursiveDeref(manager, weightNode);
+    return NULL;
+  }
+  cuddRef(res);
+  Cudd_RecursiveDeref(manager, weightNode);
+  cuddDeref(res);
+  return res;
+}
+
+/* MaxSAT: min(f + g, bound) with cube vars abstracted by min (max if additive); bound is the leaf of cube
+ * counting: f * g with cube vars abstracted by weighted sum (weighted max if not additive) */
+DdNode* Dd::getJoinAbstractionNode(DdManager* manager, DdNode* f, DdNode* g, DdNode* cube) {
+  statLine(manager);
+  if (cuddIsConstant(cube)) {
+    return maxsatSolving ? getBoundedSumNode(manager, f, g, cube) : cuddAddApplyRecur(manager, Cudd_addTimes, f, g);
+  }
+  if (!maxsatSolving && (f == DD_ZERO(manager) || g == DD_ZERO(manager))) {
+    return DD_ZERO(manager);
+  }
+  if (f > g) { // both joins are commutative, so normalizes cache key
+    std::swap(f, g);
+  }
+  DdNode* res = cuddCacheLookup(manager, DD_ADD_JOIN_ABSTRACT_TAG, f, g, cube);
+  if (res != NULL) {
+    return res;
+  }
+  checkWhetherToGiveUp(manager);
+
+  int fLevel = cuddI(manager, f->index);
+  int gLevel = cuddI(manager, g->index);
+  int topLevel = min(fLevel, gLevel);
+  int cubeLevel = cuddI(manager, cube->index);
+  DdHalfWord cubeVar = cube->index;
+
+  if (cubeLevel < topLevel) { // neither f nor g depends on cube var
+    DdNode* R = getJoinAbstractionNode(manager, f, g, cuddT(cube));
+    if (R == NULL) {
+      return NULL;
+    }
+    if (maxsatSolving) { // min and max are idempotent
+      res = R;
+    }
+    else {
+      cuddRef(R);
+      Float negativeWeight = ddVarNegativeWeights.at(cubeVar);
+      Float positiveWeight = ddVarPositiveWeights.at(cubeVar);
+      res = getWeightedNode(manager, R, ddVarAdditivity.at(cubeVar) ? negativeWeight + positiveWeight : max(negativeWeight, positiveWeight));
+      if (res == NULL) {
+        Cudd_RecursiveDeref(manager, R);
+        return NULL;
+      }
+      cuddRef(res);
+      Cudd_RecursiveDeref(manager, R);
+      cuddDeref(res);
+    }
+    cuddCacheInsert(manager, DD_ADD_JOIN_ABSTRACT_TAG, f, g, cube, res);
+    return res;
+  }
+
+  DdHalfWord index = fLevel <= gLevel ? f->index : g->index;
+  DdNode* fThen = fLevel <= gLevel ? cuddT(f) : f;
+  DdNode* fElse = fLevel <= gLevel ? cuddE(f) : f;
+  DdNode* gThen = gLevel <= fLevel ? cuddT(g) : g;
+  DdNode* gElse = gLevel <= fLevel ? cuddE(g) : g;
+  bool abstracting = cubeLevel == topLevel;
+  DdNode* nextCube = abstracting ? cuddT(cube) : cube;
+
+  DdNode* T = getJoinAbstractionNode(manager, fThen, gThen, nextCube);
+  if (T == NULL) {
+    return NULL;
+  }
+  cuddRef(T);
+  DdNode* E = getJoinAbstractionNode(manager, fElse, gElse, nextCube);
+  if (E == NULL) {
+    Cudd_RecursiveDeref(manager, T);
+    return NULL;
+  }
+  cuddRef(E);
+
+  if (!abstracting) {
+    res = T == E ? T : cuddUniqueInter(manager, index, T, E);
+    if (res == NULL) {
+      Cudd_RecursiveDeref(manager, T);
+      Cudd_RecursiveDeref(manager, E);
+      return NULL;
+    }
+    cuddDeref(T);
+    cuddDeref(E);
+  }
+  else if (maxsatSolving) {
+    res = cuddAddApplyRecur(manager, ddVarAdditivity.at(cubeVar) ? Cudd_addMaximum : Cudd_addMinimum, T, E); // additive vars are max vars in Min-MaxSAT
+    if (res == NULL) {
+      Cudd_RecursiveDeref(manager, T);
+      Cudd_RecursiveDeref(manager, E);
+      return NULL;
+    }
+    cuddRef(res);
+    Cudd_RecursiveDeref(manager, T);
+    Cudd_RecursiveDeref(manager, E);
+    cuddDeref(res);
+  }
+  else {
+    DdNode* weightedT = getWeightedNode(manager, T, ddVarPositiveWeights.at(cubeVar));
+    if (weightedT == NULL) {
+      Cudd_RecursiveDeref(manager, T);
+      Cudd_RecursiveDeref(manager, E);
+      return NULL;
+    }
+    cuddRef(weightedT);
+    DdNode* weightedE = getWeightedNode(manager, E, ddVarNegativeWeights.at(cubeVar));
+    if (weightedE == NULL) {
+      Cudd_RecursiveDeref(manager, T);
+      Cudd_RecursiveDeref(manager, E);
+      Cudd_RecursiveDeref(manager, weightedT);
+      return NULL;
+    }
+    cuddRef(weightedE);
+    res = cuddAddApplyRecur(manager, ddVarAdditivity.at(cubeVar) ? Cudd_addPlus : Cudd_addMaximum, weightedT, weightedE);
+    if (res == NULL) {
+      Cudd_RecursiveDeref(manager, T);
+      Cudd_RecursiveDeref(manager, E);
+      Cudd_RecursiveDeref(manager, weightedT);
+      Cudd_RecursiveDeref(manager, weightedE);
+      return NULL;
+    }
+    cuddRef(res);
+    Cudd_RecursiveDeref(manager, T);
+    Cudd_RecursiveDeref(manager, E);
+    Cudd_RecursiveDeref(manager, weightedT);
+    Cudd_RecursiveDeref(manager, weightedE);
+    cuddDeref(res);
+  }
+  cuddCacheInsert(manager, DD_ADD_JOIN_ABSTRACT_TAG, f, g, cube, res);
+  return res;
+}
+
+Dd Dd::getJoinAbstraction(const Dd& dd, const vector<Int>& ddVars, Int bound, const Cudd* mgr) const {
+  assert(ddPackage == CUDD && !logCounting);
+#ifdef NOTHRESHOLD
+  bound = LLONG_MAX;
+#endif
+  DdManager* manager = mgr->getManager();
+  ADD cube = getCubeAdd(ddVars, maxsatSolving ? bound : 1, mgr); // keeps cube alive during recursion
+  DdNode* res;
+  do { // same retry loop as Cudd_addApply
+    manager->reordered = 0;
+    res = getJoinAbstractionNode(manager, cuadd.getNode(), dd.cuadd.getNode(), cube.getNode());
+  } while (manager->reordered == 1);
+  if (res == NULL) {
+    throw MyError("join abstraction failed | CUDD error code ", Cudd_ReadErrorCode(manager));
+  }
+  return Dd(ADD(*mgr, res));
+}
+
+Dd Dd::getCubeAbstraction(const vector<Int>& ddVars, Int bound, const Cudd* mgr) const {
+  return getJoinAbstraction(maxsatSolving ? getZeroDd(mgr) : getOneDd(mgr), ddVars, bound, mgr); // joins with identity
 }
 
 Dd Dd::getSum(const Dd& dd) const {
@@ -565,32 +900,36 @@ Dd Dd::getSum(const Dd& dd) const {
     LACE_ME;
     return Dd(Mtbdd(gmp_plus(mtbdd.GetMTBDD(), dd.mtbdd.GetMTBDD())));
   }
-  std::cout<<"package besides CUDD is not supported for this function: getSum";
-  exit(1);
+  return Dd(mtbdd + dd.mtbdd);
 }
 
 Dd Dd::getSubtraction(const Dd& dd) const {
   if (ddPackage == CUDD) {
     return Dd(cuadd - dd.cuadd);
   }
-  std::cout<<"package besides CUDD is not supported for this function: getSubstraction";
-  exit(1);
+  if (multiplePrecision) {
+    LACE_ME;
+    return Dd(Mtbdd(gmp_minus(mtbdd.GetMTBDD(), dd.mtbdd.GetMTBDD())));
+  }
+  return Dd(mtbdd - dd.mtbdd);
 }
 
 Dd Dd::getXOR(const Dd& dd) const {
   if (ddPackage == CUDD) {
     return Dd(cuadd.Xor(dd.cuadd));
   }
-  std::cout<<"package besides CUDD is not supported for this function: getXOR";
-  exit(1);
+  return getMax(dd).getSubtraction(getMin(dd)); // 0-1 operands
 }
 
 Dd Dd::getMin(const Dd& dd) const {
   if (ddPackage == CUDD) {
     return Dd(cuadd.Minimum(dd.cuadd));
   }
-  std::cout<<"package besides CUDD is not supported for this function: getMin";
-  exit(1);
+  if (multiplePrecision) {
+    LACE_ME;
+    return Dd(Mtbdd(gmp_min(mtbdd.GetMTBDD(), dd.mtbdd.GetMTBDD())));
+  }
+  return Dd(mtbdd.Min(dd.mtbdd));
 }
 
 Dd Dd::getMax(const Dd& dd) const {
@@ -605,28 +944,106 @@ Dd Dd::getMax(const Dd& dd) const {
 }
 
 Float Dd::getMaxValue() const {
-  return Dd(cuadd.FindMax()).extractConst().fraction;
+  if (std::isnan(maxValue)) {
+    if (ddPackage == CUDD) {
+      maxValue = cuddV(cuadd.FindMax().getNode());
+    }
+    else {
+      cacheLeafStats();
+    }
+  }
+  return maxValue;
 }
 
 Float Dd::getMinValue() const {
-  return Dd(cuadd.FindMin()).extractConst().fraction;
+  if (std::isnan(minValue)) {
+    if (ddPackage == CUDD) {
+      minValue = cuddV(cuadd.FindMin().getNode());
+    }
+    else {
+      cacheLeafStats();
+    }
+  }
+  return minValue;
+}
+
+Int Dd::countLeaves() const {
+  if (leafCount < 0) {
+    if (ddPackage == CUDD) {
+      leafCount = Cudd_CountLeaves(cuadd.getNode());
+    }
+    else {
+      cacheLeafStats();
+    }
+  }
+  return leafCount;
+}
+
+void Dd::cacheLeafStats() const {
+  Set<MTBDD> visitedNodes;
+  vector<MTBDD> nodeStack = {mtbdd.GetMTBDD()};
+  minValue = INF;
+  maxValue = -INF;
+  leafCount = 0;
+  while (!nodeStack.empty()) {
+    MTBDD node = nodeStack.back();
+    nodeStack.pop_back();
+    if (!visitedNodes.insert(node).second) {
+      continue;
+    }
+    if (mtbdd_isleaf(node)) {
+      Float value = multiplePrecision ? mpq_class((mpq_ptr)mtbdd_getvalue(node)).get_d() : mtbdd_getdouble(node);
+      minValue = min(minValue, value);
+      maxValue = max(maxValue, value);
+      leafCount++;
+    }
+    else {
+      nodeStack.push_back(mtbdd_getlow(node));
+      nodeStack.push_back(mtbdd_gethigh(node));
+    }
+  }
+}
+
+/* an apply visits at most one node per pair of operand nodes, but shared vars make the operands
+ * move in lockstep, so the smaller operand counts less the more of its support is shared;
+ * also, there is at most one node per union var and leaf pair */
+Float Dd::getJoinCost(const Dd& dd) const {
+  const Dd& smallDd = countNodes() <= dd.countNodes() ? *this : dd;
+  const Dd& bigDd = countNodes() <= dd.countNodes() ? dd : *this;
+  const Set<Int>& smallSupport = smallDd.getSupport();
+  const Set<Int>& bigSupport = bigDd.getSupport();
+  Int overlap = 0;
+  for (Int ddVar : smallSupport) {
+    if (bigSupport.contains(ddVar)) {
+      overlap++;
+    }
+  }
+  Int unionSize = smallSupport.size() + bigSupport.size() - overlap;
+  Float sharedRatio = smallSupport.empty() ? 1 : static_cast<Float>(overlap) / smallSupport.size();
+  Float applyBound = log2l(bigDd.countNodes()) + (1 - sharedRatio) * log2l(smallDd.countNodes());
+  Float widthBound = log2l(unionSize + 1) + log2l(countLeaves()) + log2l(dd.countLeaves());
+  return min(applyBound, widthBound);
 }
 
-Set<Int> Dd::getSupport() const {
-  Set<Int> support;
+const Set<Int>& Dd::getSupport() const {
+  if (support) {
+    return *support;
+  }
+  Set<Int> ddVars;
   if (ddPackage == CUDD) {
     for (Int ddVar : cuadd.SupportIndices()) {
-      support.insert(ddVar);
+      ddVars.insert(ddVar);
     }
   }
   else {
     Mtbdd cube = mtbdd.Support(); // conjunction of all vars appearing in mtbdd
     while (!cube.isOne()) {
-      support.insert(cube.TopVar());
+      ddVars.insert(cube.TopVar());
       cube = cube.Then();
     }
   }
-  return support;
+  support = std::make_shared<const Set<Int>>(ddVars);
+  return *support;
 }
 
 Dd Dd::getAbstraction(Int ddVar, const vector<Int>& ddVarToCnfVarMap, const Map<Int, Number>& literalWeights, const Assignment& assignment, bool additive, const Cudd* mgr) const {
@@ -645,6 +1062,14 @@ Dd Dd::getAbstraction(Int ddVar, const vector<Int>& ddVarToCnfVarMap, const Map<
 
 /* getAbstractionMaxSAT now uses getMin becasuse MaxSAT is turned into a minimization problem */
 Dd Dd::getAbstractionMaxSAT(Int ddVar, const vector<Int>& ddVarToCnfVarMap, const Map<Int, Number>& literalWeights, const Assignment& assignment, bool additive, const Cudd* mgr) const {
+  if (ddPackage == SYLVAN) {
+    LACE_ME;
+    MTBDD cube = mtbdd_makenode(ddVar, sylvan::mtbdd_false, sylvan::mtbdd_true); // var set {ddVar}
+    if (multiplePrecision) {
+      return Dd(Mtbdd(additive ? gmp_abstract_max(mtbdd.GetMTBDD(), cube) : gmp_abstract_min(mtbdd.GetMTBDD(), cube)));
+    }
+    return Dd(Mtbdd(additive ? mtbdd_abstract_max(mtbdd.GetMTBDD(), cube) : mtbdd_abstract_min(mtbdd.GetMTBDD(), cube)));
+  }
   Dd term0 = getComposition(ddVar, false, mgr);
   Dd term1 = getComposition(ddVar, true, mgr);
 #ifdef MAXBYBA
@@ -687,6 +1112,64 @@ Dd Dd::getAbstractionMaxSATBA(Int ddVar, const vector<Int>& ddVarToCnfVarMap, co
   return *this;
 }
 
+void Dd::writeAddFile(const string& filePath) const {
+  assert(ddPackage == CUDD);
+  std::ofstream file(filePath);
+  if (!file) {
+    throw MyError("unable to write ADD file '", filePath, "'");
+  }
+  file << std::hexfloat; // exact leaf values
+  Map<DdNode*, Int> nodeLines; // node |-> 0-indexed line, children before parents
+  vector<pair<DdNode*, bool>> nodeStack = {{cuadd.getNode(), false}}; // (node, whether children are written)
+  while (!nodeStack.empty()) {
+    auto [node, expanded] = nodeStack.back();
+    nodeStack.pop_back();
+    if (nodeLines.contains(node)) {
+      continue;
+    }
+    if (cuddIsConstant(node)) {
+      file << "v " << cuddV(node) << "\n";
+    }
+    else if (!expanded) {
+      nodeStack.push_back({node, true});
+      nodeStack.push_back({cuddE(node), false});
+      nodeStack.push_back({cuddT(node), false});
+      continue;
+    }
+    else {
+      file << "n " << node->index << " " << nodeLines.at(cuddT(node)) << " " << nodeLines.at(cuddE(node)) << "\n";
+    }
+    Int line = nodeLines.size();
+    nodeLines[node] = line;
+  }
+  if (!file) {
+    throw MyError("unable to write ADD file '", filePath, "'");
+  }
+}
+
+Dd Dd::readAddFile(const string& filePath, const Cudd* mgr) {
+  assert(ddPackage == CUDD);
+  std::ifstream file(filePath);
+  if (!file) {
+    throw MyError("unable to read ADD file '", filePath, "'");
+  }
+  vector<ADD> nodes; // by line
+  string line;
+  while (getline(file, line)) {
+    vector<string> words = util::splitInputLine(line);
+    if (words.at(0) == "v") {
+      nodes.push_back(mgr->constant(strtod(words.at(1).c_str(), nullptr))); // strtod reads hexfloat
+    }
+    else {
+      nodes.push_back(mgr->addVar(stoll(words.at(1))).Ite(nodes.at(stoll(words.at(2))), nodes.at(stoll(words.at(3))))); // Ite tolerates reordering since writing
+    }
+  }
+  if (nodes.empty()) {
+    throw MyError("empty ADD file '", filePath, "'");
+  }
+  return Dd(nodes.back());
+}
+
 void Dd::writeDotFile(const Cudd* mgr, string dotFileDir) const {
   string filePath = dotFileDir + "dd" + to_string(dotFileIndex++) + ".dot";
   FILE* file = fopen(filePath.c_str(), "wb"); // writes to binary file
@@ -711,6 +1194,370 @@ void Dd::writeInfoFile(const Cudd* mgr, string filePath) {
   cout << "c overwrote file " << filePath << "\n";
 }
 
+/* class JoinQueue ========================================================== */
+
+JoinQueue::JoinQueue(const vector<Dd>& childDdList) {
+  for (const Dd& childDd : childDdList) {
+    push(childDd);
+  }
+}
+
+size_t JoinQueue::size() const {
+  return joinPriority == CHEAPEST_PAIR ? liveDds.size() : sizeQueue.size();
+}
+
+void JoinQueue::push(const Dd& dd) {
+  if (joinPriority != CHEAPEST_PAIR) { // Dd::operator< handles both biggest-first and smallest-first
+    sizeQueue.push(dd);
+    return;
+  }
+  Int index = pushCount++;
+  for (const auto& [otherIndex, otherDd] : liveDds) {
+    pairQueue.push({dd.getJoinCost(otherDd), otherIndex, index});
+  }
+  liveDds.insert({index, dd});
+}
+
+pair<Dd, Dd> JoinQueue::popPair() {
+  assert(size() > 1);
+  if (joinPriority != CHEAPEST_PAIR) {
+    Dd dd1 = sizeQueue.top();
+    sizeQueue.pop();
+    Dd dd2 = sizeQueue.top();
+    sizeQueue.pop();
+    return {dd1, dd2};
+  }
+  while (true) {
+    auto [cost, index1, index2] = pairQueue.top();
+    pairQueue.pop();
+    auto it1 = liveDds.find(index1);
+    auto it2 = liveDds.find(index2);
+    if (it1 != liveDds.end() && it2 != liveDds.end()) { // skips pairs with an already joined ADD
+      pair<Dd, Dd> ddPair = {it1->second, it2->second};
+      liveDds.erase(it1);
+      liveDds.erase(it2);
+      return ddPair;
+    }
+  }
+}
+
+Dd JoinQueue::popLast() {
+  assert(size() == 1);
+  if (joinPriority != CHEAPEST_PAIR) {
+    Dd dd = sizeQueue.top();
+    sizeQueue.pop();
+    return dd;
+  }
+  Dd dd = liveDds.begin()->second;
+  liveDds.clear();
+  return dd;
+}
+
+/* classes for scheduling slices ============================================ */
+
+/* class SliceQueue ========================================================= */
+
+bool SliceQueue::isSplittable(const Assignment& assignment) const {
+  return assignment.size() < sliceVarOrder.size();
+}
+
+void SliceQueue::pushSlice(const Assignment& assignment, Int threadIndex) {
+  {
+    const std::lock_guard<mutex> g(queueMutex);
+    threadDeques.at(threadIndex).push_back(assignment);
+    pendingSliceCount++;
+  }
+  queueCondition.notify_all();
+}
+
+bool SliceQueue::popSlice(Assignment& assignment, Int threadIndex) {
+  std::unique_lock<mutex> lock(queueMutex);
+  while (true) {
+    deque<Assignment>& ownDeque = threadDeques.at(threadIndex);
+    if (!ownDeque.empty()) {
+      assignment = ownDeque.back();
+      ownDeque.pop_back();
+      return true;
+    }
+    for (Int i = 1; i < threadDeques.size(); i++) { // steals oldest (biggest) slice from next busy thread
+      deque<Assignment>& victimDeque = threadDeques.at((threadIndex + i) % threadDeques.size());
+      if (!victimDeque.empty()) {
+        assignment = victimDeque.front();
+        victimDeque.pop_front();
+        return true;
+      }
+    }
+    if (pendingSliceCount == 0) {
+      return false;
+    }
+    queueCondition.wait(lock); // running slices may still be split
+  }
+}
+
+void SliceQueue::finishSlice() {
+  {
+    const std::lock_guard<mutex> g(queueMutex);
+    pendingSliceCount--;
+  }
+  queueCondition.notify_all();
+}
+
+Int SliceQueue::getSplitVar(const Assignment& assignment) const {
+  for (Int var : sliceVarOrder) {
+    if (!assignment.contains(var)) {
+      return var;
+    }
+  }
+  throw MyError("no unassigned slice var to split on");
+}
+
+void SliceQueue::splitSlice(const Assignment& assignment, Int threadIndex) {
+  Int var = getSplitVar(assignment);
+  if (verboseSolving >= 1) {
+    const std::lock_guard<mutex> g(queueMutex);
+    cout << "c thread " << right << setw(4) << threadIndex + 1 << " | splitting slice { ";
+    assignment.printAssignment();
+    cout << " } on var " << var << "\n";
+  }
+  for (bool val : {false, true}) {
+    Assignment extendedAssignment = assignment;
+    extendedAssignment[var] = val;
+    pushSlice(extendedAssignment, threadIndex);
+  }
+}
+
+SliceQueue::SliceQueue(const vector<Assignment>& assignments, const vector<Int>& sliceVarOrder, Int threadCount) {
+  this->sliceVarOrder = sliceVarOrder;
+  threadDeques = vector<deque<Assignment>>(threadCount);
+  for (Int assignmentIndex = 0; assignmentIndex < assignments.size(); assignmentIndex++) {
+    threadDeques.at(assignmentIndex % threadCount).push_back(assignments.at(assignmentIndex));
+  }
+  pendingSliceCount = assignments.size();
+}
+
+/* class SubtreeTask ======================================================== */
+
+SubtreeTask::SubtreeTask(const JoinNode* joinNode, const Cudd* mgr) {
+  this->joinNode = joinNode;
+  this->mgr = mgr;
+}
+
+/* class SubtreeFrame ======================================================= */
+
+SubtreeFrame::SubtreeFrame(const JoinNode* joinNode) {
+  this->joinNode = joinNode;
+  childOrder = Executor::childOrders.at(joinNode->nodeIndex);
+  for (JoinNode* child : childOrder) {
+    if (!child->isTerminal()) {
+      lastNonterminalChild = child;
+    }
+  }
+  subtreeTasks.reserve(childOrder.size()); // workers keep references to tasks
+}
+
+/* class LocalSearcher ====================================================== */
+
+bool LocalSearcher::isTrue(Int literal) const {
+  return vals.at(abs(literal)) == (literal > 0);
+}
+
+bool LocalSearcher::isFalsified(Int constraint, Int sum) const {
+  switch (types.at(constraint)) {
+    case 'x':
+      return sum % 2 == 0;
+    case 'p':
+      return comparators.at(constraint) == 2 ? sum != rhses.at(constraint) : sum < rhses.at(constraint);
+    default:
+      return sum == 0;
+  }
+}
+
+void LocalSearcher::setFalsified(Int constraint, bool falsified) {
+  Int& position = falsifiedPositions.at(constraint);
+  if (falsified == (position != MIN_INT)) {
+    return;
+  }
+  vector<Int>& falsifiedConstraints = hardConstraints.at(constraint) ? falsifiedHardConstraints : falsifiedSoftConstraints;
+  if (falsified) {
+    position = falsifiedConstraints.size();
+    falsifiedConstraints.push_back(constraint);
+  }
+  else { // moves last falsified constraint into the gap
+    Int lastConstraint = falsifiedConstraints.back();
+    falsifiedConstraints.at(position) = lastConstraint;
+    falsifiedPositions.at(lastConstraint) = position;
+    falsifiedConstraints.pop_back();
+    position = MIN_INT;
+  }
+  if (!hardConstraints.at(constraint)) {
+    softCost += (falsified ? 1 : -1) * weights.at(constraint);
+  }
+}
+
+Int LocalSearcher::getScore(Int var) const {
+  Int score = 0;
+  const vector<tuple<Int, Int, Int>>& terms = varTerms.at(var);
+  for (Int termIndex = 0; termIndex < terms.size();) {
+    Int constraint = std::get<0>(terms.at(termIndex));
+    Int sum = constraintSums.at(constraint);
+    for (; termIndex < terms.size() && std::get<0>(terms.at(termIndex)) == constraint; termIndex++) { // var may occur as both literals
+      Int literal = std::get<1>(terms.at(termIndex));
+      Int coef = std::get<2>(terms.at(termIndex));
+      sum += isTrue(literal) ? -coef : coef;
+    }
+    bool falsified = isFalsified(constraint, sum);
+    if (falsified != (falsifiedPositions.at(constraint) != MIN_INT)) {
+      score += falsified ? -dynamicWeights.at(constraint) : dynamicWeights.at(constraint);
+    }
+  }
+  return score;
+}
+
+void LocalSearcher::flipVar(Int var) {
+  for (const auto& [constraint, literal, coef] : varTerms.at(var)) {
+    constraintSums.at(constraint) += isTrue(literal) ? -coef : coef;
+  }
+  vals.at(var) = !vals.at(var);
+  for (const auto& [constraint, literal, coef] : varTerms.at(var)) {
+    setFalsified(constraint, isFalsified(constraint, constraintSums.at(constraint)));
+  }
+  flipSteps.at(var) = ++step;
+  lastFlippedVar = var;
+}
+
+void LocalSearcher::updateWeights() {
+  if (std::uniform_real_distribution<Float>(0, 1)(generator) < LOCAL_SEARCH_SMOOTHING_PROBABILITY) { // forgets old local optima
+    for (Int constraint = 0; constraint < dynamicWeights.size(); constraint++) {
+      Int& dynamicWeight = dynamicWeights.at(constraint);
+      if (hardConstraints.at(constraint) && falsifiedPositions.at(constraint) == MIN_INT && dynamicWeight > 1) {
+        dynamicWeight = max(dynamicWeight - LOCAL_SEARCH_HARD_WEIGHT_INCREMENT, static_cast<Int>(1));
+      }
+    }
+    return;
+  }
+  for (Int constraint : falsifiedHardConstraints) { // soft weights stay fixed, so falsified soft constraints are traded by their cost
+    dynamicWeights.at(constraint) += LOCAL_SEARCH_HARD_WEIGHT_INCREMENT;
+  }
+}
+
+Int LocalSearcher::pickFalsifiedConstraint() {
+  const vector<Int>& falsifiedConstraints = falsifiedHardConstraints.empty() ? falsifiedSoftConstraints : falsifiedHardConstraints;
+  return falsifiedConstraints.at(generator() % falsifiedConstraints.size());
+}
+
+Int LocalSearcher::pickVar() {
+  Int bestVar = MIN_INT;
+  Int bestScore = 0;
+  for (Int sampleIndex = 0; sampleIndex < LOCAL_SEARCH_SAMPLE_COUNT; sampleIndex++) { // greedy step: only improving vars
+    Int constraint = pickFalsifiedConstraint();
+    const vector<pair<Int, Int>>& terms = constraintTerms.at(constraint);
+    Int var = abs(terms.at(generator() % terms.size()).first);
+    Int score = getScore(var);
+    if (score > bestScore || (score == bestScore && bestVar != MIN_INT && flipSteps.at(var) < flipSteps.at(bestVar))) {
+      bestVar = var;
+      bestScore = score;
+    }
+  }
+  if (bestVar != MIN_INT) {
+    return bestVar;
+  }
+
+  updateWeights(); // local optimum
+  Int constraint = pickFalsifiedConstraint();
+  const vector<pair<Int, Int>>& terms = constraintTerms.at(constraint);
+  Int sampleCount = min(static_cast<Int>(terms.size()), LOCAL_SEARCH_SAMPLE_COUNT);
+  for (Int sampleIndex = 0; sampleIndex < sampleCount; sampleIndex++) {
+    Int termIndex = terms.size() <= LOCAL_SEARCH_SAMPLE_COUNT ? sampleIndex : generator() % terms.size();
+    Int var = abs(terms.at(termIndex).first);
+    if (var == lastFlippedVar) { // would undo last step
+      continue;
+    }
+    Int score = getScore(var);
+    if (bestVar == MIN_INT || score > bestScore || (score == bestScore && flipSteps.at(var) < flipSteps.at(bestVar))) {
+      bestVar = var;
+      bestScore = score;
+    }
+  }
+  return bestVar == MIN_INT ? abs(terms.front().first) : bestVar;
+}
+
+void LocalSearcher::search() {
+  if (infeasible) {
+    return;
+  }
+  Int bestCost = LLONG_MAX;
+  while (!Executor::localSearchStopping) {
+    if (falsifiedHardConstraints.empty() && softCost < bestCost) {
+      bestCost = softCost;
+      Executor::updateLocalSearchModel(vals, softCost);
+    }
+    if (falsifiedHardConstraints.empty() && falsifiedSoftConstraints.empty()) { // no cost left to remove
+      return;
+    }
+    flipVar(pickVar());
+  }
+}
+
+LocalSearcher::LocalSearcher(const Cnf& cnf, Int seed) {
+  generator.seed(seed);
+  vals = vector<bool>(cnf.declaredVarCount + 1);
+  for (Int var = 1; var <= cnf.declaredVarCount; var++) {
+    vals.at(var) = generator() % 2;
+  }
+  flipSteps = vector<Int>(cnf.declaredVarCount + 1);
+  varTerms = vector<vector<tuple<Int, Int, Int>>>(cnf.declaredVarCount + 1);
+
+  Int maxSoftWeight = 0;
+  for (Int clauseIndex = 0; clauseIndex < cnf.clauses.size(); clauseIndex++) {
+    Int weight = (Int) cnf.weights.at(clauseIndex);
+    if (cnf.trivialBoundPartialMaxSAT == LLONG_MAX || weight < cnf.trivialBoundPartialMaxSAT) {
+      maxSoftWeight = max(maxSoftWeight, weight);
+    }
+  }
+
+  for (Int clauseIndex = 0; clauseIndex < cnf.clauses.size(); clauseIndex++) {
+    Int weight = (Int) cnf.weights.at(clauseIndex);
+    if (weight == 0) { // no cost either way
+      continue;
+    }
+    Int constraint = types.size();
+    types.push_back(cnf.types.at(clauseIndex));
+    comparators.push_back(cnf.comparators.at(clauseIndex));
+    rhses.push_back(cnf.klist.at(clauseIndex));
+    weights.push_back(weight);
+    hardConstraints.push_back(cnf.trivialBoundPartialMaxSAT < LLONG_MAX && weight >= cnf.trivialBoundPartialMaxSAT);
+    constraintTerms.push_back({});
+    Int sum = 0;
+    for (Int literal : cnf.clauses.at(clauseIndex)) {
+      Int coef = types.back() == 'p' ? cnf.coefLists.at(clauseIndex).at(literal) : 1;
+      constraintTerms.back().push_back({literal, coef});
+      varTerms.at(abs(literal)).push_back({constraint, literal, coef});
+      sum += isTrue(literal) ? coef : 0;
+    }
+    constraintSums.push_back(sum);
+    Int softWeight = maxSoftWeight > LOCAL_SEARCH_SOFT_WEIGHT_LIMIT ? static_cast<Int>(static_cast<Float>(weight) * LOCAL_SEARCH_SOFT_WEIGHT_LIMIT / maxSoftWeight) : weight;
+    dynamicWeights.push_back(hardConstraints.back() ? 1 : max(softWeight, static_cast<Int>(1)));
+    falsifiedPositions.push_back(MIN_INT);
+    if (constraintTerms.back().empty()) { // no var can change it, so it is not searched on
+      if (isFalsified(constraint, sum)) {
+        infeasible = infeasible || hardConstraints.back();
+        softCost += hardConstraints.back() ? 0 : weight;
+      }
+      types.pop_back();
+      comparators.pop_back();
+      rhses.pop_back();
+      weights.pop_back();
+      hardConstraints.pop_back();
+      constraintTerms.pop_back();
+      constraintSums.pop_back();
+      dynamicWeights.pop_back();
+      falsifiedPositions.pop_back();
+      continue;
+    }
+    setFalsified(constraint, isFalsified(constraint, sum));
+  }
+}
+
 /* class Executor =========================================================== */
 
 Map<Int, Float> Executor::varDurations;
@@ -769,283 +1616,1166 @@ void Executor::printVarDdSizes() {
   }
 }
 
-Dd Executor::getClauseDd(const Map<Int, Int>& cnfVarToDdVarMap, const Clause& clause, const Cudd* mgr, const Assignment& assignment) {
-  Dd clauseDd = Dd::getZeroDd(mgr);
+Int Executor::getDdVarLevel(Int ddVar, const Cudd* mgr) {
+  if (ddPackage == CUDD) {
+    mgr->addVar(ddVar); // ReadPerm needs var in manager
+    return mgr->ReadPerm(ddVar);
+  }
+  return ddVar; // Sylvan orders vars by index
+}
+
+Dd Executor::getClauseDd(const Map<Int, Int>& cnfVarToDdVarMap, const Clause& clause, const Dd& trueDd, const Dd& falseDd, const Cudd* mgr, const Assignment& assignment) {
+  Map<Int, bool> literals; // ddVar |-> val of unassigned literals
   for (Int literal : clause) {
     bool val = literal > 0;
     Int cnfVar = abs(literal);
     auto it = assignment.find(cnfVar);
     if (it != assignment.end()) { // slices clause on literal
       if (it->second == val) { // returns satisfied clause
-        return Dd::getOneDd(mgr);
+        return trueDd;
       } // excludes unsatisfied literal from clause otherwise
+      continue;
     }
-    else {
-      Int ddVar = cnfVarToDdVarMap.at(cnfVar);
-      Dd literalDd = Dd::getVarDd(ddVar, val, mgr);
-      clauseDd = clauseDd.getMax(literalDd);
+    auto [literalIt, inserted] = literals.insert({cnfVarToDdVarMap.at(cnfVar), val});
+    if (!inserted && literalIt->second != val) { // tautology
+      return trueDd;
     }
   }
-  return clauseDd;
-}
 
-bool find_var(const vector<Int>& v, Int i){
+  vector<pair<Int, Int>> levels; // (level, ddVar)
+  for (auto [ddVar, val] : literals) {
+    levels.push_back({getDdVarLevel(ddVar, mgr), ddVar});
+  }
+  sort(levels.begin(), levels.end(), greater<pair<Int, Int>>()); // bottom var first
+
+  Dd clauseDd = falseDd; // all literals below are false
+  for (auto [level, ddVar] : levels) {
+    clauseDd = literals.at(ddVar) ? Dd::getNodeDd(ddVar, trueDd, clauseDd, mgr) : Dd::getNodeDd(ddVar, clauseDd, trueDd, mgr);
+  }
+  return clauseDd;
+}
+
+bool find_var(const vector<Int>& v, Int i){
   for (auto j : v)
     if (abs(j) == i) return true;
   return false;
 }
 
-int signOfTerm(const vector<Int>& term){
-  int sign = 1;
-  for (auto literal : term){
-    int j = 2 * int(literal > 0) - 1;
-    sign *= j;
+int signOfTerm(const vector<Int>& term){
+  int sign = 1;
+  for (auto literal : term){
+    int j = 2 * int(literal > 0) - 1;
+    sign *= j;
+  }
+  std::cout<<"sgn="<<sign<<std::endl;
+  return sign;
+}
+
+Dd Executor::getClauseSDd(const Map<Int, Int>& cnfVarToDdVarMap, const Clause& clause, const Cudd* mgr, const Assignment& assignment) {
+  vector<Int> lits;
+  vector<Int> sig;
+  int n = 10;
+  std::cout<<"sdd"<<std::endl;
+  Dd zero = Dd::getZeroDd(mgr);
+  Dd one = Dd::getOneDd(mgr);
+  Dd ans = Dd::getZeroDd(mgr);
+  vector<vector<Int> > terms;
+  vector<Int> clauseVec;
+  for (Int literal : clause) {
+    clauseVec.push_back(literal);
+  }
+  terms.push_back({clauseVec[0]});
+  terms.push_back({clauseVec[1]});
+  terms.push_back({clauseVec[2]});
+  terms.push_back({clauseVec[1],clauseVec[2]});
+  terms.push_back({clauseVec[0],clauseVec[1]});
+  terms.push_back({clauseVec[0],clauseVec[2]});
+  terms.push_back({clauseVec[0],clauseVec[1],clauseVec[2]});
+  for (auto term : terms){
+    int sign = signOfTerm(term);
+    Dd res = Dd::getZeroDd(mgr);
+    for (int i = 1; i <= n ;i++){
+      bool flag = find_var(term, i);
+      Int ddVarT = cnfVarToDdVarMap.at(i);
+      Dd literalDd = Dd::getVarDd(ddVarT, 1, mgr);
+      if (i == 1){
+        res = (flag == 1) ? Dd ( literalDd.cuadd.Ite(one.cuadd * mgr->constant(-0.125 * sign), zero.cuadd)) : Dd ( literalDd.cuadd.Ite(zero.cuadd, one.cuadd * mgr->constant(-0.125 * sign) ));
+      }
+      else{
+        res = (flag == 1) ? Dd ( literalDd.cuadd.Ite(res.cuadd,zero.cuadd)) : Dd ( literalDd.cuadd.Ite(zero.cuadd,res.cuadd));
+      }
+    }
+    res.writeDotFile(mgr);
+    ans = Dd(ans.cuadd + res.cuadd);
+  }
+  ans = Dd(ans.cuadd + mgr->constant(0.875));
+  // ans.writeDotFile(mgr);
+  return ans;
+}
+
+Dd Executor::getXORDd(const Map<Int, Int>& cnfVarToDdVarMap, const Clause& clause, const Dd& trueDd, const Dd& falseDd, const Cudd* mgr, const Assignment& assignment) {
+  bool parity = false; // XOR is satisfied iff parity of true literals is odd
+  Set<Int> ddVars; // of unassigned vars occurring an odd number of times
+  for (Int literal : clause) {
+    bool val = literal > 0;
+    Int cnfVar = abs(literal);
+    if (!val) { // -x = x XOR 1
+      parity = !parity;
+    }
+    auto it = assignment.find(cnfVar);
+    if (it != assignment.end()) { // slices clause on literal
+      if (it->second) {
+        parity = !parity;
+      }
+      continue;
+    }
+    Int ddVar = cnfVarToDdVarMap.at(cnfVar);
+    if (!ddVars.erase(ddVar)) { // x XOR x = 0
+      ddVars.insert(ddVar);
+    }
+  }
+
+  vector<pair<Int, Int>> levels; // (level, ddVar)
+  for (Int ddVar : ddVars) {
+    levels.push_back({getDdVarLevel(ddVar, mgr), ddVar});
+  }
+  sort(levels.begin(), levels.end(), greater<pair<Int, Int>>()); // bottom var first
+
+  Dd evenDd = falseDd; // for even parity of true literals above
+  Dd oddDd = trueDd;
+  for (auto [level, ddVar] : levels) {
+    Dd newEvenDd = Dd::getNodeDd(ddVar, oddDd, evenDd, mgr);
+    oddDd = Dd::getNodeDd(ddVar, evenDd, oddDd, mgr);
+    evenDd = newEvenDd;
+  }
+  return parity ? oddDd : evenDd;
+}
+
+tuple<Int, Int, Dd> Executor::getPBIntervalDd(Int termIndex, Int rhs, const vector<tuple<Int, bool, Int>>& terms, const vector<Int>& suffixCoefSums, Int comparator, vector<map<Int, pair<Int, Dd>>>& intervalLayers, const Dd& trueDd, const Dd& falseDd, const Cudd* mgr) {
+  if (comparator == 1 && rhs <= 0) { // >=
+    return {-PB_INTERVAL_INF, 0, trueDd};
+  }
+  if (rhs > suffixCoefSums.at(termIndex)) {
+    return {suffixCoefSums.at(termIndex) + 1, PB_INTERVAL_INF, falseDd};
+  }
+  if (comparator == 2 && rhs < 0) { // =
+    return {-PB_INTERVAL_INF, -1, falseDd};
+  }
+  if (termIndex == terms.size()) { // = with rhs 0
+    return {0, 0, trueDd};
+  }
+
+  map<Int, pair<Int, Dd>>& intervalLayer = intervalLayers.at(termIndex); // lower end |-> (upper end, node)
+  auto it = intervalLayer.upper_bound(rhs);
+  if (it != intervalLayer.begin() && rhs <= prev(it)->second.first) { // rhs is in an interval of equivalent partial sums
+    return {prev(it)->first, prev(it)->second.first, prev(it)->second.second};
+  }
+
+  auto [ddVar, val, coef] = terms.at(termIndex);
+  auto [trueLower, trueUpper, trueChild] = getPBIntervalDd(termIndex + 1, rhs - coef, terms, suffixCoefSums, comparator, intervalLayers, trueDd, falseDd, mgr); // literal is true
+  auto [falseLower, falseUpper, falseChild] = getPBIntervalDd(termIndex + 1, rhs, terms, suffixCoefSums, comparator, intervalLayers, trueDd, falseDd, mgr);
+  Int lower = max(trueLower == -PB_INTERVAL_INF ? trueLower : trueLower + coef, falseLower);
+  Int upper = min(trueUpper == PB_INTERVAL_INF ? trueUpper : trueUpper + coef, falseUpper);
+  Dd dd = val ? Dd::getNodeDd(ddVar, trueChild, falseChild, mgr) : Dd::getNodeDd(ddVar, falseChild, trueChild, mgr);
+  intervalLayer.insert({lower, {upper, dd}});
+  return {lower, upper, dd};
+}
+
+Dd Executor::getPBDd(const Map<Int, Int>& cnfVarToDdVarMap, const Map<Int, Int>& coefs, Int comparator, Int rhs, const Dd& trueDd, const Dd& falseDd, const Cudd* mgr, const Assignment& assignment) {
+  Map<Int, Int> varCoefs; // cnfVar |-> coef of positive literal minus coef of negative literal
+  for (auto [literal, coef] : coefs) {
+    assert(coef > 0);
+    Int cnfVar = abs(literal);
+    bool val = literal > 0;
+    auto it = assignment.find(cnfVar);
+    if (it != assignment.end()) { // slices constraint on literal
+      if (it->second == val) {
+        rhs -= coef;
+      }
+      continue;
+    }
+    if (val) {
+      varCoefs[cnfVar] += coef;
+    }
+    else { // c * -x = c - c * x
+      varCoefs[cnfVar] -= coef;
+      rhs -= coef;
+    }
+  }
+  vector<tuple<Int, bool, Int>> terms; // (ddVar, val, coef) of unassigned literals, one per var
+  for (auto [cnfVar, varCoef] : varCoefs) {
+    if (varCoef > 0) {
+      terms.push_back({cnfVarToDdVarMap.at(cnfVar), true, varCoef});
+    }
+    else if (varCoef < 0) { // c * x = c - c * -x for c < 0
+      terms.push_back({cnfVarToDdVarMap.at(cnfVar), false, -varCoef});
+      rhs -= varCoef;
+    }
+  }
+
+  Map<Int, Int> levels; // ddVar |-> level
+  for (const auto& [ddVar, val, coef] : terms) {
+    levels[ddVar] = getDdVarLevel(ddVar, mgr);
+  }
+  sort(terms.begin(), terms.end(), [&](const tuple<Int, bool, Int>& t1, const tuple<Int, bool, Int>& t2) {
+    return levels.at(std::get<0>(t1)) < levels.at(std::get<0>(t2));
+  }); // top var first, so nodes are built bottom-up in diagram order
+
+  vector<Int> suffixCoefSums(terms.size() + 1, 0); // of terms from index onward
+  for (Int termIndex = terms.size() - 1; termIndex >= 0; termIndex--) {
+    suffixCoefSums.at(termIndex) = suffixCoefSums.at(termIndex + 1) + std::get<2>(terms.at(termIndex));
+  }
+
+  vector<map<Int, pair<Int, Dd>>> intervalLayers(terms.size());
+  return std::get<2>(getPBIntervalDd(0, rhs, terms, suffixCoefSums, comparator, intervalLayers, trueDd, falseDd, mgr));
+}
+
+Map<Int, vector<JoinNode*>> Executor::childOrders;
+std::atomic<Int> Executor::peakLiveDiagramCount;
+std::atomic<Int> Executor::peakLiveNodeCount;
+
+void Executor::setChildOrders(const JoinNonterminal* joinRoot) {
+  childOrders.clear();
+  Map<Int, Float> predictedSizes; // nodeIndex |-> predicted size of ADD of subtree
+  Map<Int, Float> predictedNeeds; // nodeIndex |-> predicted peak size of live ADDs while solving subtree
+  vector<pair<const JoinNode*, bool>> nodeStack = {{joinRoot, false}}; // (node, whether children are done)
+  while (!nodeStack.empty()) {
+    auto [joinNode, expanded] = nodeStack.back();
+    nodeStack.pop_back();
+    if (joinNode->isTerminal()) {
+      predictedSizes[joinNode->nodeIndex] = predictedNeeds[joinNode->nodeIndex] = joinNode->preProjectionVars.size() + 1;
+    }
+    else if (!expanded) {
+      nodeStack.push_back({joinNode, true});
+      for (JoinNode* child : joinNode->children) {
+        nodeStack.push_back({child, false});
+      }
+    }
+    else { // Sethi-Ullman: children that need most beyond what they hold go first
+      vector<JoinNode*> childOrder = joinNode->children;
+      std::stable_sort(childOrder.begin(), childOrder.end(), [&](JoinNode* a, JoinNode* b) {
+        return predictedNeeds.at(a->nodeIndex) - predictedSizes.at(a->nodeIndex) > predictedNeeds.at(b->nodeIndex) - predictedSizes.at(b->nodeIndex);
+      });
+      Float heldSize = 0;
+      Float need = 0;
+      for (JoinNode* child : childOrder) {
+        need = max(need, heldSize + predictedNeeds.at(child->nodeIndex));
+        heldSize += predictedSizes.at(child->nodeIndex);
+      }
+      predictedSizes[joinNode->nodeIndex] = joinNode->getPostProjectionVars().size() + 1;
+      predictedNeeds[joinNode->nodeIndex] = max(need, heldSize);
+      childOrders[joinNode->nodeIndex] = childOrder;
+    }
+  }
+}
+
+void Executor::updatePeak(std::atomic<Int>& peak, Int value) {
+  Int oldPeak = peak;
+  while (value > oldPeak) {
+    if (peak.compare_exchange_weak(oldPeak, value)) {
+      return;
+    }
+  }
+}
+
+std::atomic<Int> Executor::spillFileCount;
+
+bool Executor::isNearMemLimit(const Cudd* mgr) {
+  DdManager* manager = mgr->getManager();
+  size_t liveMem = static_cast<size_t>(Cudd_ReadKeys(manager) - Cudd_ReadDead(manager)) * sizeof(DdNode) + static_cast<size_t>(Cudd_ReadCacheSlots(manager)) * sizeof(DdCache); // CUDD keeps freed node chunks, so Cudd_ReadMemoryInUse never drops after garbage collection
+  return liveMem > SPILL_MEM_FRACTION * manager->maxmem;
+}
+
+Int Executor::spillParkedDds(vector<SubtreeFrame>& frames) {
+  Int spilledCount = 0;
+  for (SubtreeFrame& frame : frames) {
+    vector<Dd> keptDds;
+    for (const Dd& childDd : frame.childDdList) {
+      if (childDd.countNodes() < SPILL_MIN_NODE_COUNT) {
+        keptDds.push_back(childDd);
+        continue;
+      }
+      string filePath = spillDir + "/dmc_" + to_string(getpid()) + "_" + to_string(spillFileCount++) + ".add";
+      childDd.writeAddFile(filePath);
+      frame.spillFilePaths.push_back(filePath);
+      spilledCount++;
+    }
+    frame.childDdList = keptDds;
+  }
+  return spilledCount;
+}
+
+Int Executor::reloadSpilledDds(SubtreeFrame& frame, const Cudd* mgr) {
+  for (const string& filePath : frame.spillFilePaths) {
+    frame.childDdList.push_back(Dd::readAddFile(filePath, mgr));
+    std::remove(filePath.c_str());
+  }
+  Int reloadedCount = frame.spillFilePaths.size();
+  frame.spillFilePaths.clear();
+  return reloadedCount;
+}
+
+std::atomic<Int> Executor::hardenedConstraintCount;
+
+Dd Executor::solveTerminal(const JoinNode* joinNode, const Map<Int, Int>& cnfVarToDdVarMap, Int &LB, map<int, Dd> &allADDs, const Cudd* mgr, const Assignment& assignment) {
+  TimePoint terminalStartPoint = util::getTimePoint();
+
+  char type = JoinNode::cnf.types.at(joinNode->nodeIndex);
+  Int weight = (Int) JoinNode::cnf.weights.at(joinNode->nodeIndex);
+  Map<Int, Int> coefs = JoinNode::cnf.coefLists.at(joinNode->nodeIndex);
+  Int k = JoinNode::cnf.klist.at(joinNode->nodeIndex);
+  Int comparator = JoinNode::cnf.comparators.at(joinNode->nodeIndex);
+  Dd d = Dd::getZeroDd(mgr);  // the ADD representing the hybrid constraint
+#if !defined(MAXBYPUREBA) && !defined(NOTHRESHOLD)
+  if (maxsatSolving && !minMaxsatSolving) { // LB sums mins of ADDs joined so far, which exclude this constraint
+    Int bound = getPruningBound();
+    if (weight < bound && weight >= bound - LB) { // violating assignments cost at least LB + weight, so they are pruned anyway
+      weight = bound; // 0/bound mask saturates bounded sums at once
+      hardenedConstraintCount++;
+    }
+  }
+#endif
+  Dd weightDd = Dd::getIntDd(weight, mgr);
+  Dd trueDd = maxsatSolving ? Dd::getZeroDd(mgr) : weightDd; // leaves are weighted from the start, so no product below
+  Dd falseDd = maxsatSolving ? weightDd : Dd::getZeroDd(mgr); // cost of unsatisfied constraint for maxsat; 0 for model counting
+  if (type == 'c') //CNF clause
+    d = getClauseDd(cnfVarToDdVarMap, JoinNode::cnf.clauses.at(joinNode->nodeIndex), trueDd, falseDd, mgr, assignment);
+  else if (type == 'x'){ // XOR constraint
+    d = getXORDd(cnfVarToDdVarMap, JoinNode::cnf.clauses.at(joinNode->nodeIndex), trueDd, falseDd, mgr, assignment);
+  }
+  else if (type == 'p'){ // PB constraints
+    d = getPBDd(cnfVarToDdVarMap, coefs, comparator, k, trueDd, falseDd, mgr, assignment);
+  }
+  updateVarDurations(joinNode, terminalStartPoint);
+  updateVarDdSizes(joinNode, d);
+#ifndef MAXBYPUREBA
+  if (maxsatSolving) {
+    LB += d.getMinValue(); // joins subtract child mins
+  }
+#endif
+#ifdef MAXBYPUREBA
+  d.setOfADDIndex.push_back(joinNode->nodeIndex); // for Basic Algorithm
+  allADDs.insert(std::make_pair(joinNode->nodeIndex, d));
+#endif
+  return d;
+}
+
+Dd Executor::solveNonterminal(const JoinNode* joinNode, vector<Dd>& childDdList, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Int &LB, stack<pair<int, Dd> > &stackMaximizer, map<int, Dd> &allADDs, const Cudd* mgr, const Assignment& assignment, TimePoint sliceStartPoint) {
+  Set<Int> abstractedVars; // projection vars already abstracted by cube
+
+#ifdef MAXBYPUREBA
+  Dd dd = Dd::getZeroDd(mgr);
+  for (const Dd& childDd : childDdList) {
+    dd.setOfADDIndex.insert(dd.setOfADDIndex.end(), childDd.setOfADDIndex.begin(), childDd.setOfADDIndex.end());
+  }
+  childDdList.clear();
+#else
+  TimePoint nonterminalStartPoint = util::getTimePoint();
+  Dd dd = maxsatSolving ? Dd::getZeroDd(mgr) : Dd::getOneDd(mgr);
+#ifdef MAXIMIZER
+  bool fusingLastJoin = false; // Gx needs the joined ADD
+#else
+  bool fusingLastJoin = ddPackage == CUDD && !logCounting && joinPriority != ARBITRARY_PAIR && childDdList.size() > 1;
+#endif
+  if (joinPriority == ARBITRARY_PAIR) { // arbitrarily multiplies child ADDs
+    while (!childDdList.empty()) {
+      Dd childDd = childDdList.back();
+      childDdList.pop_back(); // releases child ADD once joined
+      Int oldLB = LB;
+      LB -=  childDd.getMinValue();
+      LB -=  dd.getMinValue();
+      dd = maxsatSolving ? dd.getSum(childDd) :  dd.getProduct(childDd);
+      LB += dd.getMinValue();
+      if ( LB > oldLB)
+        std::cout<<"c lower bound: "<<LB<<std::endl;
+      checkSliceBound(LB, assignment);
+      checkSliceBudget(dd, sliceStartPoint);
+    }
+  }
+  else {
+    Map<Int, Int> projectionVarOccurrences; // unassigned projection ddVar |-> number of queued ADDs mentioning it
+    if (fusingLastJoin) { // cube kernels are available, so vars are abstracted as soon as they become private
+      for (Int cnfVar : joinNode->projectionVars) {
+        if (!assignment.contains(cnfVar)) {
+          projectionVarOccurrences[cnfVarToDdVarMap.at(cnfVar)] = 0;
+        }
+      }
+      for (const Dd& childDd : childDdList) {
+        for (Int ddVar : childDd.getSupport()) {
+          auto it = projectionVarOccurrences.find(ddVar);
+          if (it != projectionVarOccurrences.end()) {
+            it->second++;
+          }
+        }
+      }
+    }
+
+    JoinQueue childDdQueue(childDdList);
+    childDdList.clear(); // queue owns child ADDs, which are released as they are joined
+    assert(childDdQueue.size() > 0);
+    while (childDdQueue.size() > (fusingLastJoin ? 2 : 1)) {
+      Int oldLB = LB;
+      auto [dd1, dd2] = childDdQueue.popPair();
+      LB -= dd1.getMinValue();
+      LB -= dd2.getMinValue();
+      vector<Int> privateDdVars; // mentioned by no other queued ADD
+      for (const Dd* joinedDd : {&dd1, &dd2}) {
+        for (Int ddVar : joinedDd->getSupport()) {
+          auto it = projectionVarOccurrences.find(ddVar);
+          if (it != projectionVarOccurrences.end() && --it->second == 0) {
+            privateDdVars.push_back(ddVar);
+            abstractedVars.insert(ddVarToCnfVarMap.at(ddVar));
+            projectionVarOccurrences.erase(it);
+          }
+        }
+      }
+      Int upperBoundOfUNSATClauses = getPruningBound();
+      Dd dd3 = !privateDdVars.empty() ? dd1.getJoinAbstraction(dd2, privateDdVars, upperBoundOfUNSATClauses, mgr) :
+        maxsatSolving ? dd1.getBoundedSum(dd2, upperBoundOfUNSATClauses, mgr) : dd1.getProduct(dd2); // prunes the ADD while joining; counts are never capped
+      for (Int ddVar : dd3.getSupport()) {
+        auto it = projectionVarOccurrences.find(ddVar);
+        if (it != projectionVarOccurrences.end()) {
+          it->second++;
+        }
+      }
+      LB += dd3.getMinValue();
+      childDdQueue.push(dd3);
+      if ( LB > oldLB) std::cout<<"c lower bound: "<<LB<<std::endl;
+      checkSliceBound(LB, assignment);
+      checkSliceBudget(dd3, sliceStartPoint);
+    }
+    if (fusingLastJoin) {
+      Int oldLB = LB;
+      auto [dd1, dd2] = childDdQueue.popPair();
+      LB -= dd1.getMinValue();
+      LB -= dd2.getMinValue();
+      vector<Int> cubeDdVars;
+      for (Int cnfVar : joinNode->projectionVars) {
+        if (!assignment.contains(cnfVar) && !abstractedVars.contains(cnfVar)) { // assigned vars are absent from child ADDs
+          cubeDdVars.push_back(cnfVarToDdVarMap.at(cnfVar));
+          abstractedVars.insert(cnfVar);
+        }
+      }
+      dd = dd1.getJoinAbstraction(dd2, cubeDdVars, getPruningBound(), mgr);
+      LB += dd.getMinValue();
+      if ( LB > oldLB) std::cout<<"c lower bound: "<<LB<<std::endl;
+      checkSliceBound(LB, assignment);
+    }
+    else {
+      dd = childDdQueue.popLast();
+    }
+  }
+#endif
+
+#if !defined(MAXIMIZER) && !defined(MAXBYPUREBA)
+  if (ddPackage == CUDD && !logCounting) {
+    vector<Int> cubeDdVars;
+    for (Int cnfVar : joinNode->projectionVars) {
+      if (!abstractedVars.contains(cnfVar) && !assignment.contains(cnfVar)) {
+        cubeDdVars.push_back(cnfVarToDdVarMap.at(cnfVar));
+        abstractedVars.insert(cnfVar);
+      }
+    }
+    if (!cubeDdVars.empty()) {
+      dd = dd.getCubeAbstraction(cubeDdVars, getPruningBound(), mgr);
+    }
+  }
+#endif
+
+  for (Int cnfVar : joinNode->projectionVars) { // assigned vars, or all vars without cube kernels
+    if (abstractedVars.contains(cnfVar)) {
+      continue;
+    }
+    Int ddVar = cnfVarToDdVarMap.at(cnfVar);
+#ifdef MAXIMIZER
+    if (maxsatSolving){
+      Dd term0 = dd.getComposition(ddVar, false, mgr);
+      Dd term1 = dd.getComposition(ddVar, true, mgr);
+      Dd diff = Dd(term1.cuadd - term0.cuadd);
+      Dd Gx = Dd(diff.cuadd.BddThreshold(0).Add());
+      stackMaximizer.push(std::make_pair(ddVar, Gx));
+    }
+#endif
+#ifdef MAXBYPUREBA
+    dd = dd.getAbstractionMaxSATBA(ddVar, ddVarToCnfVarMap, JoinNode::cnf.literalWeights, assignment, JoinNode::cnf.additiveVars.contains(cnfVar), allADDs, mgr);
+#else
+    dd = maxsatSolving ? dd.getAbstractionMaxSAT(ddVar, ddVarToCnfVarMap, JoinNode::cnf.literalWeights, assignment, JoinNode::cnf.additiveVars.contains(cnfVar), mgr) \
+    : dd.getAbstraction(ddVar, ddVarToCnfVarMap, JoinNode::cnf.literalWeights, assignment, JoinNode::cnf.additiveVars.contains(cnfVar), mgr);
+#endif
+  }
+#ifndef MAXBYPUREBA
+  updateVarDurations(joinNode, nonterminalStartPoint);
+  updateVarDdSizes(joinNode, dd);
+  Int numNodes =  dd.countNodes();
+    if ( numNodes > maxOfADDNodes ){
+      maxOfADDNodes = numNodes;
+  }
+  checkSliceBudget(dd, sliceStartPoint);
+#endif
+  return dd;
+}
+
+Dd Executor::solveSubtree(const JoinNode* joinNode, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Int &LB, stack<pair<int, Dd> > &stackMaximizer, map<int, Dd> &allADDs,  const Cudd* mgr, const Assignment& assignment, TimePoint sliceStartPoint, Map<Int, Dd>* nodeDds) {
+  if (joinNode->isTerminal()) {
+    return solveTerminal(joinNode, cnfVarToDdVarMap, LB, allADDs, mgr, assignment);
+  }
+
+  vector<SubtreeFrame> frames; // explicit post-order stack, so deep join trees cannot overflow the call stack
+  frames.emplace_back(joinNode);
+  Int liveDiagramCount = 0; // child ADDs held by frames
+#ifdef MAXBYPUREBA
+  bool spilling = false; // allADDs keeps every ADD anyway
+#else
+  bool spilling = ddPackage == CUDD && !spillDir.empty();
+#endif
+#if defined(MAXIMIZER) || defined(MAXBYPUREBA)
+  bool checkpointing = false; // Gx ADDs and allADDs are not checkpointed
+#else
+  bool checkpointing = ddPackage == CUDD && !checkpointDir.empty();
+#endif
+  TimePoint checkpointPoint = util::getTimePoint();
+  try {
+    while (true) {
+      SubtreeFrame& frame = frames.back(); // invalidated by emplace_back
+      if (frame.childIndex < frame.childOrder.size()) {
+        JoinNode* child = frame.childOrder.at(frame.childIndex++);
+        if (child->isTerminal()) {
+          frame.childDdList.push_back(solveTerminal(child, cnfVarToDdVarMap, LB, allADDs, mgr, assignment));
+          if (nodeDds != nullptr) {
+            nodeDds->insert_or_assign(child->nodeIndex, frame.childDdList.back());
+          }
+          updatePeak(peakLiveDiagramCount, ++liveDiagramCount);
+          if (spilling && isNearMemLimit(mgr)) {
+            Int spilledCount = spillParkedDds(frames);
+            if (spilledCount > 0) { // otherwise collecting would free nothing parked
+              liveDiagramCount -= spilledCount;
+              cuddGarbageCollect(mgr->getManager(), 1);
+            }
+          }
+          continue;
+        }
+        if (checkpointing && std::filesystem::exists(getSubtreeCheckpointPath(assignment, child->nodeIndex))) { // from previous run
+          frame.childDdList.push_back(Dd::readAddFile(getSubtreeCheckpointPath(assignment, child->nodeIndex), mgr));
+          if (maxsatSolving) {
+            LB += frame.childDdList.back().getMinValue(); // joins subtract child mins
+          }
+          updatePeak(peakLiveDiagramCount, ++liveDiagramCount);
+          continue;
+        }
+#if defined(MAXIMIZER) || defined(MAXBYPUREBA)
+        bool offloading = false; // Gx ADDs and allADDs must stay in mgr
+#else
+        bool offloading = ddPackage == CUDD && nodeDds == nullptr && child != frame.lastNonterminalChild && idleSubtreeThreadCount > 0 && child->getWidth(assignment) >= SUBTREE_TASK_MIN_WIDTH && acquireSubtreeThread();
+#endif
+        if (offloading) {
+          frame.subtreeTasks.emplace_back(child, acquireSubtreeMgr(mgr->getManager()->threadIndex));
+          SubtreeTask& task = frame.subtreeTasks.back();
+          task.worker = thread(solveSubtreeTask, std::ref(task), std::cref(cnfVarToDdVarMap), std::cref(ddVarToCnfVarMap), std::cref(assignment), sliceStartPoint);
+        }
+        else {
+          frames.emplace_back(child);
+        }
+        continue;
+      }
+
+      liveDiagramCount += reloadSpilledDds(frame, mgr);
+      Int localChildCount = frame.childDdList.size();
+      finishSubtreeTasks(frame.subtreeTasks, frame.childDdList, LB, mgr);
+      liveDiagramCount += frame.childDdList.size() - localChildCount; // transferred from workers
+      updatePeak(peakLiveDiagramCount, liveDiagramCount);
+      liveDiagramCount -= frame.childDdList.size();
+      Dd dd = solveNonterminal(frame.joinNode, frame.childDdList, cnfVarToDdVarMap, ddVarToCnfVarMap, LB, stackMaximizer, allADDs, mgr, assignment, sliceStartPoint);
+      Int nodeIndex = frame.joinNode->nodeIndex;
+      if (nodeDds != nullptr) {
+        nodeDds->insert_or_assign(nodeIndex, dd);
+      }
+      frames.pop_back(); // releases child ADDs
+      if (frames.empty()) {
+        return dd;
+      }
+      if (checkpointing && util::getDuration(checkpointPoint) >= checkpointSeconds) {
+        string filePath = getSubtreeCheckpointPath(assignment, nodeIndex);
+        dd.writeAddFile(filePath + ".tmp");
+        std::filesystem::rename(filePath + ".tmp", filePath); // atomic, so a preempted write leaves no partial ADD
+        checkpointPoint = util::getTimePoint();
+      }
+      if (ddPackage == CUDD && reorderingMethod != NO_REORDERING) { // child ADDs of solved node are released by now
+        reorderOnGrowth(nodeIndex, dd, mgr);
+      }
+      frames.back().childDdList.push_back(dd);
+      updatePeak(peakLiveDiagramCount, ++liveDiagramCount);
+      if (spilling && isNearMemLimit(mgr)) {
+        Int spilledCount = spillParkedDds(frames);
+        if (spilledCount > 0) { // otherwise collecting would free nothing parked
+          liveDiagramCount -= spilledCount;
+          cuddGarbageCollect(mgr->getManager(), 1);
+        }
+      }
+    }
+  }
+  catch (...) {
+    for (SubtreeFrame& frame : frames) {
+      finishSubtreeTasks(frame.subtreeTasks, frame.childDdList, LB, mgr, false);
+      for (const string& filePath : frame.spillFilePaths) {
+        std::remove(filePath.c_str());
+      }
+    }
+    throw;
+  }
+}
+
+Assignment Executor::bestMaximizer;
+std::optional<Number> Executor::bestMaximizerCost;
+
+Assignment Executor::getMaximizer(const JoinNonterminal* joinRoot, const Map<Int, Dd>& nodeDds, const vector<Int>& ddVarToCnfVarMap, const Cudd* mgr, const Assignment& assignment) {
+  Map<Int, Int> cnfVarToDdVarMap;
+  for (Int ddVar = 0; ddVar < ddVarToCnfVarMap.size(); ddVar++) {
+    cnfVarToDdVarMap[ddVarToCnfVarMap.at(ddVar)] = ddVar;
+  }
+  Assignment maximizer = assignment;
+  vector<const JoinNonterminal*> nodeStack = {joinRoot}; // pre-order, so vars of ancestors are chosen first
+  while (!nodeStack.empty()) {
+    const JoinNonterminal* joinNode = nodeStack.back();
+    nodeStack.pop_back();
+    Dd dd = Dd::getZeroDd(mgr); // joined children restricted to choices so far, so only projection vars remain
+    for (const JoinNode* child : joinNode->children) {
+      Dd childDd = nodeDds.at(child->nodeIndex);
+      Set<Int> support = childDd.getSupport(); // copied since childDd is reassigned
+      for (Int ddVar : support) {
+        auto it = maximizer.find(ddVarToCnfVarMap.at(ddVar));
+        if (it != maximizer.end()) {
+          childDd = childDd.getComposition(ddVar, it->second, mgr);
+        }
+      }
+      dd = dd.getSum(childDd);
+      if (!child->isTerminal()) {
+        nodeStack.push_back(static_cast<const JoinNonterminal*>(child));
+      }
+    }
+    for (Int cnfVar : joinNode->projectionVars) {
+      if (maximizer.contains(cnfVar)) {
+        continue;
+      }
+      Int ddVar = cnfVarToDdVarMap.at(cnfVar);
+      Dd dd0 = dd.getComposition(ddVar, false, mgr);
+      Dd dd1 = dd.getComposition(ddVar, true, mgr);
+      bool val = dd1.getMinValue() < dd0.getMinValue();
+      maximizer[cnfVar] = val;
+      dd = val ? dd1 : dd0;
+    }
+  }
+  return maximizer;
+}
+
+void Executor::printMaximizerRow(const Assignment& maximizer) {
+  cout << "v";
+  for (Int var = 1; var <= JoinNode::cnf.declaredVarCount; var++) {
+    auto it = maximizer.find(var);
+    cout << " " << (it != maximizer.end() && it->second ? var : -var); // vars in no clause are set false
+  }
+  cout << "\n";
+}
+
+std::atomic<Int> Executor::idleSubtreeThreadCount;
+Float Executor::subtreeThreadMem;
+
+bool Executor::acquireSubtreeThread() {
+  Int idleCount = idleSubtreeThreadCount;
+  while (idleCount > 0) {
+    if (idleSubtreeThreadCount.compare_exchange_weak(idleCount, idleCount - 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+vector<const Cudd*> Executor::idleSubtreeMgrs;
+mutex Executor::subtreeMgrMutex;
+
+const Cudd* Executor::acquireSubtreeMgr(Int threadIndex) {
+  {
+    const std::lock_guard<mutex> g(subtreeMgrMutex);
+    if (!idleSubtreeMgrs.empty()) {
+      const Cudd* mgr = idleSubtreeMgrs.back();
+      idleSubtreeMgrs.pop_back();
+      return mgr;
+    }
+  }
+  return Dd::newMgr(subtreeThreadMem, threadIndex); // at most subtreeThreadCount managers are ever made
+}
+
+void Executor::releaseSubtreeMgr(const Cudd* mgr) {
+  Dd::recycleMgr(mgr);
+  const std::lock_guard<mutex> g(subtreeMgrMutex);
+  idleSubtreeMgrs.push_back(mgr);
+}
+
+void Executor::solveSubtreeTask(SubtreeTask& task, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, const Assignment& assignment, TimePoint sliceStartPoint) {
+  try {
+    stack<pair<int, Dd> > stackMaximizer;
+    map<int, Dd> allADDs;
+    task.dd = new Dd(solveSubtree(task.joinNode, cnfVarToDdVarMap, ddVarToCnfVarMap, task.LB, stackMaximizer, allADDs, task.mgr, assignment, sliceStartPoint));
+  }
+  catch (...) { // rethrown by parent thread
+    task.exception = std::current_exception();
+  }
+}
+
+void Executor::finishSubtreeTasks(vector<SubtreeTask>& tasks, vector<Dd>& childDdList, Int& LB, const Cudd* mgr, bool transferring) {
+  std::exception_ptr exception;
+  for (SubtreeTask& task : tasks) {
+    task.worker.join();
+    idleSubtreeThreadCount++;
+    if (task.exception) {
+      if (!exception) {
+        exception = task.exception;
+      }
+    }
+    else if (transferring && !exception) {
+      childDdList.push_back(task.dd->getTransfer(mgr));
+      LB += task.LB;
+    }
+    delete task.dd; // dereferences nodes before their manager is recycled
+    releaseSubtreeMgr(task.mgr);
+  }
+  tasks.clear(); // all joined
+  if (exception && transferring) {
+    std::rethrow_exception(exception);
+  }
+}
+
+std::atomic<Int> Executor::incumbentCost(LLONG_MAX);
+bool Executor::sliceSolved;
+
+Int Executor::getStaticBound() {
+  return maxsatBound < LLONG_MAX ? maxsatBound - JoinNode::cnf.costOffset : JoinNode::cnf.trivialBoundPartialMaxSAT; // given by user (for formula before preprocessing) or by partial MaxSAT instance
+}
+
+Int Executor::getPruningBound() {
+  return min(getStaticBound(), incumbentCost.load()); // costs at least the incumbent cannot win the min over slices
+}
+
+void Executor::updateIncumbentCost(Int cost) {
+  if (cost >= getStaticBound()) { // e.g. infeasible slice, which must not be streamed as a model
+    return;
+  }
+  Int oldCost = incumbentCost;
+  while (cost < oldCost) {
+    if (incumbentCost.compare_exchange_weak(oldCost, cost)) {
+      return;
+    }
+  }
+}
+
+void Executor::checkSliceBound(Int LB, const Assignment& assignment) {
+  if (isAnytime()) {
+    const std::lock_guard<mutex> g(boundMutex);
+    auto it = pendingSliceLBs.find(getSliceKey(assignment));
+    if (it != pendingSliceLBs.end() && LB > it->second) {
+      it->second = LB;
+      reportBounds();
+    }
+  }
+  if (maxsatSolving && !minMaxsatSolving && LB >= incumbentCost) { // costs are non-negative, so LB only grows
+    throw SliceBoundException();
+  }
+}
+
+void Executor::checkSliceBudget(const Dd& dd, TimePoint sliceStartPoint) {
+  if (sliceStartPoint == TimePoint()) { // unbudgeted slice
+    return;
+  }
+  if (sliceSecondsBudget > 0 && util::getDuration(sliceStartPoint) > sliceSecondsBudget) {
+    throw SliceBudgetException();
+  }
+  if (sliceNodesBudget > 0 && dd.countNodes() > sliceNodesBudget) {
+    throw SliceBudgetException();
+  }
+}
+
+mutex Executor::boundMutex;
+bool Executor::solvingFinished;
+Map<string, Int> Executor::pendingSliceLBs;
+bool Executor::slicingStarted;
+Int Executor::reportedLB;
+Int Executor::reportedUB = LLONG_MAX;
+
+bool Executor::isAnytime() {
+  return maxsatSolving && !minMaxsatSolving;
+}
+
+void Executor::reportBounds() {
+  if (solvingFinished) {
+    return;
+  }
+  Int UB = incumbentCost;
+  Int LB = reportedLB; // local search may improve UB before slices exist
+  if (slicingStarted) {
+    LB = UB;
+    for (const auto& [sliceKey, sliceLB] : pendingSliceLBs) {
+      LB = min(LB, sliceLB);
+    }
+  }
+  if (UB < reportedUB) {
+    reportedUB = UB;
+    cout << "o " << UB + JoinNode::cnf.costOffset << "\n";
+  }
+  if (LB > reportedLB) {
+    reportedLB = LB;
+    cout << "c global lower bound: " << LB + JoinNode::cnf.costOffset << "\n";
+  }
+}
+
+void Executor::splitPendingSlice(const Assignment& assignment, Int splitVar) {
+  const std::lock_guard<mutex> g(boundMutex);
+  string sliceKey = getSliceKey(assignment);
+  Int sliceLB = pendingSliceLBs[sliceKey];
+  for (bool val : {false, true}) {
+    Assignment extendedAssignment = assignment;
+    extendedAssignment[splitVar] = val;
+    pendingSliceLBs[getSliceKey(extendedAssignment)] = sliceLB; // costs only grow under more assignments
+  }
+  pendingSliceLBs.erase(sliceKey);
+}
+
+void Executor::finishPendingSlice(const Assignment& assignment) {
+  const std::lock_guard<mutex> g(boundMutex);
+  pendingSliceLBs.erase(getSliceKey(assignment));
+  reportBounds();
+}
+
+void Executor::watchDeadline() {
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGTERM);
+  int waitResult; // SIGTERM, or -1 at deadline
+  while (true) {
+    if (deadlineSeconds > 0) {
+      Float remainingSeconds = max(deadlineSeconds - util::getDuration(toolStartPoint), static_cast<Float>(0));
+      timespec timeout;
+      timeout.tv_sec = remainingSeconds;
+      timeout.tv_nsec = (remainingSeconds - timeout.tv_sec) * 1e9;
+      waitResult = sigtimedwait(&signals, nullptr, &timeout);
+    }
+    else {
+      waitResult = sigwaitinfo(&signals, nullptr);
+    }
+    if (waitResult == -1 && errno == EINTR) { // e.g. SIGALRM of JoinTreeReader
+      continue;
+    }
+    break;
+  }
+
+  const std::lock_guard<mutex> g(boundMutex);
+  if (solvingFinished) {
+    return;
+  }
+  cout << "c " << (waitResult == SIGTERM ? "received SIGTERM" : "reached deadline") << " after " << util::getDuration(toolStartPoint) << "s\n";
+  if (isAnytime()) {
+    reportBounds();
+    if (reportedUB < LLONG_MAX) {
+      cout << "o " << reportedUB + JoinNode::cnf.costOffset << "\n"; // best known upper bound as last "o" line
+    }
+    cout << "c global lower bound: " << reportedLB + JoinNode::cnf.costOffset << "\n";
+  }
+  util::printRow("s", !isAnytime() || reportedUB == LLONG_MAX ? "UNKNOWN" : "SATISFIABLE");
+  cout.flush();
+  std::_Exit(EXIT_SUCCESS); // slice threads may be deep inside diagram operations
+}
+
+void Executor::startWatchdog() {
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr); // inherited by threads created later, so only watchdog receives SIGTERM
+  thread(watchDeadline).detach();
+}
+
+void Executor::finishSolving() {
+  const std::lock_guard<mutex> g(boundMutex);
+  solvingFinished = true;
+}
+
+vector<LocalSearcher> Executor::localSearchers;
+vector<thread> Executor::localSearchThreads;
+std::atomic<bool> Executor::localSearchStopping;
+Assignment Executor::localSearchModel;
+Int Executor::localSearchCost = LLONG_MAX;
+bool Executor::localSearchCheckpointing;
+
+void Executor::updateLocalSearchModel(const vector<bool>& vals, Int cost) {
+  const std::lock_guard<mutex> g(boundMutex);
+  if (cost >= localSearchCost) { // another local-search thread was faster
+    return;
+  }
+  localSearchCost = cost;
+  if (maximizerSolving) {
+    localSearchModel.clear();
+    for (Int var = 1; var < vals.size(); var++) {
+      localSearchModel[var] = vals.at(var);
+    }
+  }
+  writeLocalSearchRecord(); // before any slice is pruned by this cost
+  updateIncumbentCost(cost);
+  reportBounds();
+}
+
+void Executor::writeLocalSearchRecord() {
+  if (localSearchCheckpointing && localSearchCost < LLONG_MAX) {
+    appendCheckpointRecord(LOCAL_SEARCH_RECORD + " 0 " + to_string(localSearchCost));
+  }
+}
+
+void Executor::startLocalSearch() {
+  localSearchStopping = false;
+  localSearchers.clear();
+  for (Int threadIndex = 0; threadIndex < localSearchThreadCount; threadIndex++) { // built before any thread starts, so vector does not move
+    localSearchers.push_back(LocalSearcher(JoinNode::cnf, randomSeed + threadIndex));
+  }
+  for (LocalSearcher& searcher : localSearchers) {
+    localSearchThreads.push_back(thread(&LocalSearcher::search, &searcher));
+  }
+}
+
+void Executor::stopLocalSearch() {
+  localSearchStopping = true;
+  for (thread& t : localSearchThreads) {
+    t.join();
   }
-  std::cout<<"sgn="<<sign<<std::endl;
-  return sign;
+  localSearchThreads.clear();
+  localSearchers.clear();
 }
 
-Dd Executor::getClauseSDd(const Map<Int, Int>& cnfVarToDdVarMap, const Clause& clause, const Cudd* mgr, const Assignment& assignment) {
-  vector<Int> lits;
-  vector<Int> sig;
-  int n = 10;
-  std::cout<<"sdd"<<std::endl;
-  Dd zero = Dd::getZeroDd(mgr);
-  Dd one = Dd::getOneDd(mgr);
-  Dd ans = Dd::getZeroDd(mgr);
-  vector<vector<Int> > terms;
-  vector<Int> clauseVec;
-  for (Int literal : clause) {
-    clauseVec.push_back(literal);
+mutex Executor::reorderingMutex;
+Map<const Cudd*, Int> Executor::reorderingBaselines;
+Int Executor::reorderingCount;
+Float Executor::reorderingSeconds;
+Int Executor::reorderingSavedNodeCount;
+
+void Executor::reorderOnGrowth(Int nodeIndex, const Dd& dd, const Cudd* mgr) {
+  Int nodeCount = dd.countNodes();
+  if (nodeCount < REORDERING_MIN_NODE_COUNT) {
+    return;
   }
-  terms.push_back({clauseVec[0]});
-  terms.push_back({clauseVec[1]});
-  terms.push_back({clauseVec[2]});
-  terms.push_back({clauseVec[1],clauseVec[2]});
-  terms.push_back({clauseVec[0],clauseVec[1]});
-  terms.push_back({clauseVec[0],clauseVec[2]});
-  terms.push_back({clauseVec[0],clauseVec[1],clauseVec[2]});
-  for (auto term : terms){
-    int sign = signOfTerm(term);
-    Dd res = Dd::getZeroDd(mgr);
-    for (int i = 1; i <= n ;i++){
-      bool flag = find_var(term, i);
-      Int ddVarT = cnfVarToDdVarMap.at(i);
-      Dd literalDd = Dd::getVarDd(ddVarT, 1, mgr);
-      if (i == 1){
-        res = (flag == 1) ? Dd ( literalDd.cuadd.Ite(one.cuadd * mgr->constant(-0.125 * sign), zero.cuadd)) : Dd ( literalDd.cuadd.Ite(zero.cuadd, one.cuadd * mgr->constant(-0.125 * sign) ));
-      }
-      else{
-        res = (flag == 1) ? Dd ( literalDd.cuadd.Ite(res.cuadd,zero.cuadd)) : Dd ( literalDd.cuadd.Ite(zero.cuadd,res.cuadd));
-      }
+  {
+    const std::lock_guard<mutex> g(reorderingMutex);
+    if (reorderingSeconds >= reorderingSecondsBudget) {
+      return;
+    }
+    auto it = reorderingBaselines.find(mgr);
+    if (it != reorderingBaselines.end() && nodeCount <= reorderingGrowth * it->second) {
+      return;
+    }
+    if (it == reorderingBaselines.end() && nodeCount <= reorderingGrowth * REORDERING_MIN_NODE_COUNT) {
+      return;
     }
-    res.writeDotFile(mgr);
-    ans = Dd(ans.cuadd + res.cuadd);
   }
-  ans = Dd(ans.cuadd + mgr->constant(0.875));
-  // ans.writeDotFile(mgr);
-  return ans;
+
+  TimePoint reorderingStartPoint = util::getTimePoint();
+  DdManager* manager = mgr->getManager();
+  Int liveNodeCount = Cudd_ReadNodeCount(manager);
+  Cudd_ReduceHeap(manager, reorderingMethod == SIFTING ? CUDD_REORDER_SIFT : CUDD_REORDER_WINDOW4, 0); // cached node counts of other Dds become estimates
+  Int savedNodeCount = liveNodeCount - Cudd_ReadNodeCount(manager);
+  Int reorderedNodeCount = dd.cuadd.nodeCount(); // dd caches its pre-reordering count
+  Float duration = util::getDuration(reorderingStartPoint);
+
+  const std::lock_guard<mutex> g(reorderingMutex);
+  reorderingBaselines[mgr] = max(reorderedNodeCount, REORDERING_MIN_NODE_COUNT);
+  reorderingCount++;
+  reorderingSeconds += duration;
+  reorderingSavedNodeCount += savedNodeCount;
+  if (verboseProfiling >= 2) {
+    util::printRow("joinNodeReorderingSeconds_" + to_string(nodeIndex + 1), duration);
+    util::printRow("joinNodeReorderingSavedNodes_" + to_string(nodeIndex + 1), savedNodeCount);
+  }
 }
 
-Dd Executor::getXORDd(const Map<Int, Int>& cnfVarToDdVarMap, const Clause& clause, const Cudd* mgr, const Assignment& assignment) {
-  Dd clauseDd = Dd::getZeroDd(mgr);
-  int parity = 0;
-  for (Int literal : clause) {
-    bool val = literal > 0;
-    Int cnfVar = abs(literal);
-    auto it = assignment.find(cnfVar);
-    if (it != assignment.end()) { // slices clause on literal
-      if (it->second == val) { // record the current parity of XOR (0 or 1)
-        parity = (parity + 1) % 2;
-      }
-    }
-    else {
-      Int ddVar = cnfVarToDdVarMap.at(cnfVar);
-      Dd literalDd = Dd::getVarDd(ddVar, val, mgr);
-      clauseDd = clauseDd.getXOR(literalDd);
-    }
+void Executor::printReorderingStats() {
+  if (ddPackage != CUDD || reorderingMethod == NO_REORDERING) {
+    return;
   }
-  clauseDd = Dd(mgr->constant(parity)).getXOR(clauseDd);
-  return clauseDd;
+  util::printRow("reorderingCount", reorderingCount);
+  util::printRow("reorderingSeconds", reorderingSeconds);
+  util::printRow("reorderingSavedNodes", reorderingSavedNodeCount);
 }
 
-Dd Executor::getPBDd(const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int> clause,
- Map<Int,Int> coefs, const int comparator,
-const int rhs, int size, Int sum, Int material_left,
-std::map<pair<Int, Int>, Dd>& hashing, const Cudd* mgr, const Assignment& assignment) {
-  pair<Int,Int> sizeSumPair = std::make_pair(size,sum);
-  if ( hashing.count(sizeSumPair)){
-    Dd res = hashing.find(sizeSumPair)->second;
-    return res;
+string Executor::checkpointKey;
+mutex Executor::checkpointMutex;
+Map<string, vector<string>> Executor::checkpointRecords;
+
+string Executor::getCheckpointString(const Number& n) {
+  if (multiplePrecision) {
+    return n.quotient.get_str();
   }
-  if (comparator == 1 ){ // >=
-    if ( sum >= rhs)
-      return Dd::getOneDd(mgr);
-    else if ( sum + material_left < rhs){
-      return Dd::getZeroDd(mgr);
+  std::ostringstream stream;
+  stream << std::hexfloat << n.fraction; // exact, and stold reads it back
+  return stream.str();
+}
+
+string Executor::getCheckpointKey(const JoinNonterminal* joinRoot, const vector<Int>& ddVarToCnfVarMap) {
+  uint64_t hash = 14695981039346656037ULL; // FNV-1a offset basis
+  auto hashInt = [&hash](Int value) {
+    for (Int byteIndex = 0; byteIndex < 8; byteIndex++) {
+      hash ^= (static_cast<uint64_t>(value) >> (8 * byteIndex)) & 0xff;
+      hash *= 1099511628211ULL; // FNV prime
     }
-  }
-  else if (comparator == 2){ // =
-    if ((sum > rhs) || (sum + material_left < rhs) ){
-      return Dd::getZeroDd(mgr);
+  };
+  auto hashString = [&hashInt](const string& s) {
+    hashInt(s.size());
+    for (char c : s) {
+      hashInt(c);
+    }
+  };
+  auto hashSet = [&hashInt](const Set<Int>& ints) { // unordered sets are hashed in sorted order
+    vector<Int> sortedInts(ints.begin(), ints.end());
+    sort(sortedInts.begin(), sortedInts.end());
+    hashInt(sortedInts.size());
+    for (Int i : sortedInts) {
+      hashInt(i);
     }
-    else if ( (material_left == 0) && (sum==rhs) ){
-      return Dd::getOneDd(mgr);
+  };
+
+  const Cnf& cnf = JoinNode::cnf;
+  hashInt(cnf.declaredVarCount);
+  for (Int clauseIndex = 0; clauseIndex < cnf.clauses.size(); clauseIndex++) {
+    hashSet(cnf.clauses.at(clauseIndex));
+    hashInt(cnf.types.at(clauseIndex));
+    hashInt(std::bit_cast<uint64_t>(cnf.weights.at(clauseIndex))); // raw double, as Number(Float) is unavailable with multiplePrecision
+    map<Int, Int> coefs(cnf.coefLists.at(clauseIndex).begin(), cnf.coefLists.at(clauseIndex).end()); // sorted
+    for (const auto& [literal, coef] : coefs) {
+      hashInt(literal);
+      hashInt(coef);
     }
+    hashInt(cnf.comparators.at(clauseIndex));
+    hashInt(cnf.klist.at(clauseIndex));
   }
-  Int literal = clause[size];
-  int cnfVar = abs(literal);
-  bool val = (literal > 0);
-  Int ddVar = cnfVarToDdVarMap.at(cnfVar);
-  Dd literalDd = Dd::getVarDd(ddVar, val, mgr);
-  Dd true_child =
-    getPBDd(cnfVarToDdVarMap, clause, coefs, comparator, rhs, size + 1, sum + coefs[literal], material_left - coefs[literal],  hashing, mgr, assignment) ;
-  Dd false_child =
-    getPBDd(cnfVarToDdVarMap, clause, coefs, comparator, rhs, size + 1, sum, material_left - coefs[literal],  hashing, mgr, assignment) ;
-  Dd res = Dd ( literalDd.cuadd.Ite(true_child.cuadd, false_child.cuadd));
-  hashing.insert(std::make_pair(sizeSumPair, res));
-  return res;
-}
+  map<Int, Number> literalWeights(cnf.literalWeights.begin(), cnf.literalWeights.end()); // sorted
+  for (const auto& [literal, weight] : literalWeights) {
+    hashInt(literal);
+    hashString(getCheckpointString(weight));
+  }
+  hashSet(cnf.additiveVars);
 
-Dd Executor::solveSubtree(const JoinNode* joinNode, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Int &LB, stack<pair<int, Dd> > &stackMaximizer, map<int, Dd> &allADDs,  const Cudd* mgr, const Assignment& assignment ) {
-  if (joinNode->isTerminal()) {
-    TimePoint terminalStartPoint = util::getTimePoint();
-
-    char type = JoinNode::cnf.types.at(joinNode->nodeIndex);
-    Int weight = (Int) JoinNode::cnf.weights.at(joinNode->nodeIndex);
-    Map<Int, Int> coefs = JoinNode::cnf.coefLists.at(joinNode->nodeIndex);
-    Int k = JoinNode::cnf.klist.at(joinNode->nodeIndex);
-    Int comparator = JoinNode::cnf.comparators.at(joinNode->nodeIndex);
-    Dd d = Dd::getZeroDd(mgr);  // the ADD representing the hybrid constraint
-    if (type == 'c') //CNF clause
-      d = maxsatSolving ? Dd(getClauseDd(cnfVarToDdVarMap, JoinNode::cnf.clauses.at(joinNode->nodeIndex), mgr, assignment).cuadd.Cmpl()) // 0 if satisfied; 1 if unsatisfied (cost) for maxsat
-                        : Dd(getClauseDd(cnfVarToDdVarMap, JoinNode::cnf.clauses.at(joinNode->nodeIndex), mgr, assignment));  // 1 if sat; 0 if UNSAT for model counting
-    else if (type == 'x'){ // XOR constraint
-      d = maxsatSolving ? Dd(getXORDd(cnfVarToDdVarMap, JoinNode::cnf.clauses.at(joinNode->nodeIndex), mgr, assignment).cuadd.Cmpl()) // for maxsat
-                        : Dd(getXORDd(cnfVarToDdVarMap, JoinNode::cnf.clauses.at(joinNode->nodeIndex), mgr, assignment)); // for model counting
-    }
-    else if (type == 'p'){ // PB constraints
-      std::map<pair<Int, Int>, Dd > hashing;
-      Set<Int> clause = JoinNode::cnf.clauses.at(joinNode->nodeIndex);
-      vector<Int> sortedClause(clause.begin(), clause.end());
-      std::sort(sortedClause.begin(), sortedClause.end(),
-        [&](Int A, Int B) -> bool {
-          return abs(coefs[A]) > abs(coefs[B]);
-        });
-      Int coefsSum = 0;
-      for (int i = 0; i < sortedClause.size(); i++){
-
-         if (coefs[sortedClause[i]] <= 0){
-            for (auto iter = clause.begin(); iter != clause.end(); iter++){
-              std::cout<<*iter<<" ";
-            }
-            std::cout<<std::endl;
-         }
-         assert(coefs[sortedClause[i]] > 0);
-         coefsSum += coefs[sortedClause[i]];
-      }
-      d = maxsatSolving ? Dd(getPBDd(cnfVarToDdVarMap, sortedClause, coefs, comparator, k, 0, 0, coefsSum, hashing, mgr, assignment).cuadd.Cmpl()) // for maxsat
-                        : Dd(getPBDd(cnfVarToDdVarMap, sortedClause, coefs, comparator, k, 0, 0, coefsSum, hashing, mgr, assignment)); // for counting
+  vector<const JoinNode*> nodeStack = {joinRoot}; // pre-order, children in stored order
+  while (!nodeStack.empty()) {
+    const JoinNode* joinNode = nodeStack.back();
+    nodeStack.pop_back();
+    hashInt(joinNode->nodeIndex);
+    hashInt(joinNode->children.size());
+    hashSet(joinNode->projectionVars);
+    for (auto it = joinNode->children.rbegin(); it != joinNode->children.rend(); it++) {
+      nodeStack.push_back(*it);
     }
-    d = d.getProduct(Dd(mgr->constant(weight))); // multiply constraint weight to ADD
-    updateVarDurations(joinNode, terminalStartPoint);
-    updateVarDdSizes(joinNode, d);
-#ifdef MAXBYPUREBA
-    d.setOfADDIndex.push_back(joinNode->nodeIndex); // for Basic Algorithm
-    allADDs.insert(std::make_pair(joinNode->nodeIndex, d));
-#endif
-    return d;
   }
 
-  vector<Dd> childDdList;
+  for (Int cnfVar : ddVarToCnfVarMap) {
+    hashInt(cnfVar);
+  }
 
-#ifdef MAXBYPUREBA
-  Dd dd = Dd::getZeroDd(mgr);
-  for (JoinNode* child : joinNode->children) {
-    vector<Int> childSetOfADDIndex = solveSubtree(child, cnfVarToDdVarMap, ddVarToCnfVarMap, LB, stackMaximizer, allADDs, mgr, assignment).setOfADDIndex;
-    dd.setOfADDIndex.insert( dd.setOfADDIndex.end(), childSetOfADDIndex.begin(), childSetOfADDIndex.end() );
+  for (bool flag : {weightedCounting, projectedCounting, maxsatSolving, minMaxsatSolving, multiplePrecision, logCounting}) {
+    hashInt(flag);
   }
-#else
-  for (JoinNode* child : joinNode->children) {
-    childDdList.push_back(solveSubtree(child, cnfVarToDdVarMap, ddVarToCnfVarMap, LB, stackMaximizer, allADDs, mgr, assignment));
+  hashInt(maxsatBound);
+  hashString(ddPackage);
+
+  std::ostringstream stream;
+  stream << std::hex << setw(16) << std::setfill('0') << hash;
+  return stream.str();
+}
+
+string Executor::getSliceKey(const Assignment& assignment) {
+  vector<Int> literals;
+  for (const auto& [var, val] : assignment) {
+    literals.push_back(val ? var : -var);
   }
+  sort(literals.begin(), literals.end(), [](Int l1, Int l2) { return abs(l1) < abs(l2); });
+  string sliceKey = "slice";
+  for (Int literal : literals) {
+    sliceKey += "." + to_string(literal); // "_" separates sliceKey from nodeIndex
+  }
+  return sliceKey;
+}
 
-  TimePoint nonterminalStartPoint = util::getTimePoint();
-  Dd dd = maxsatSolving ? Dd::getZeroDd(mgr) : Dd::getOneDd(mgr);
-  if (joinPriority == ARBITRARY_PAIR) { // arbitrarily multiplies child ADDs
-    for (Dd childDd : childDdList) {
-      Int oldLB = LB;
-      LB -=  childDd.getMinValue();
-      LB -=  dd.getMinValue();
-      dd = maxsatSolving ? dd.getSum(childDd) :  dd.getProduct(childDd);
-      LB += dd.getMinValue();
-      if ( LB > oldLB)
-        std::cout<<"c lower bound: "<<LB<<std::endl;
+string Executor::getSubtreeCheckpointPath(const Assignment& assignment, Int nodeIndex) {
+  return checkpointDir + "/" + checkpointKey + "_" + getSliceKey(assignment) + "_" + to_string(nodeIndex) + ".add";
+}
+
+void Executor::readCheckpoint() {
+  checkpointRecords.clear();
+  std::ifstream file(checkpointDir + "/" + checkpointKey + ".slices");
+  string line;
+  while (getline(file, line)) { // records are appended in order, so later records win
+    if (file.eof()) { // last record was cut off before its newline
+      break;
     }
-  }
-  else { // Dd::operator< handles both biggest-first and smallest-first
-    std::priority_queue<Dd> childDdQueue;
-    for (Dd childDd : childDdList) {
-      childDdQueue.push(childDd);
+    vector<string> words = util::splitInputLine(line);
+    if (words.empty()) {
+      continue;
     }
-    assert(!childDdQueue.empty());
-    while (childDdQueue.size() > 1) {
-      Int oldLB = LB;
-      Dd dd1 = childDdQueue.top();
-      childDdQueue.pop();
-      Dd dd2 = childDdQueue.top();
-      childDdQueue.pop();
-      LB -= dd1.getMinValue();
-      LB -= dd2.getMinValue();
-      Int upperBoundOfUNSATClauses = LLONG_MAX;
-      if (maxsatBound < LLONG_MAX){
-        upperBoundOfUNSATClauses = maxsatBound;  // upper bound of cost given by user
-      }
-      else{
-        upperBoundOfUNSATClauses = JoinNode::cnf.trivialBoundPartialMaxSAT; // upper bound of cost given by the partial MaxSAT instance
+    Assignment assignment;
+    Int wordIndex = 1;
+    for (; wordIndex < words.size() && words.at(wordIndex) != "0"; wordIndex++) {
+      Int literal = stoll(words.at(wordIndex));
+      assignment[abs(literal)] = literal > 0;
+    }
+    Int fieldCount = words.at(0) == FINISHED_SLICE_RECORD ? 2 : words.at(0) == PRUNED_SLICE_RECORD || words.at(0) == LOCAL_SEARCH_RECORD ? 1 : 0;
+    if (wordIndex + fieldCount >= words.size()) {
+      throw MyError("malformed checkpoint record '", line, "'");
+    }
+    if (words.at(0) == LOCAL_SEARCH_RECORD) { // applies to all slices
+      Int cost = stoll(words.at(wordIndex + 1));
+      const std::lock_guard<mutex> g(boundMutex);
+      localSearchCost = min(localSearchCost, cost);
+      updateIncumbentCost(cost);
+      continue;
+    }
+    vector<string> record = {words.at(0)};
+    record.insert(record.end(), words.begin() + wordIndex + 1, words.begin() + wordIndex + 1 + fieldCount);
+    checkpointRecords[getSliceKey(assignment)] = record;
+    if (record.front() == FINISHED_SLICE_RECORD && maxsatSolving && !minMaxsatSolving) {
+      Number partialSolution(record.at(2));
+      Float partialCost = multiplePrecision ? partialSolution.quotient.get_d() : partialSolution.fraction;
+      if (partialCost < LLONG_MAX) {
+        updateIncumbentCost(partialCost); // thresholds of checkpointed subtree ADDs are no lower
       }
-      Dd dd3 = maxsatSolving ? dd1.getSum(dd2) : dd1.getProduct(dd2);
-      // int beforeCount = dd3.countNodes();
-      dd3 = dd3.getThreshold(upperBoundOfUNSATClauses, mgr); // prune the ADD
-      // int afterCount = dd3.countNodes();
-      // if (afterCount < beforeCount)
-      //   std::cout<<"pruning reduces:"<<beforeCount - afterCount<<" from "<<beforeCount<<" to "<<afterCount<<std::endl;
-      LB += dd3.getMinValue();
-      childDdQueue.push(dd3);
-      if ( LB > oldLB) std::cout<<"c lower bound: "<<LB<<std::endl;
     }
-    dd = childDdQueue.top();
+  }
+  if (verboseSolving >= 1) {
+    util::printRow("checkpointKey", checkpointKey);
+    util::printRow("checkpointedSliceCount", checkpointRecords.size());
+  }
+}
 
+void Executor::appendCheckpointRecord(const string& record) {
+  const std::lock_guard<mutex> g(checkpointMutex);
+  std::ofstream file(checkpointDir + "/" + checkpointKey + ".slices", std::ios::app);
+  file << record << "\n";
+  file.flush();
+  if (!file) {
+    throw MyError("unable to write checkpoint dir '", checkpointDir, "'");
   }
-#endif
+}
 
-  for (Int cnfVar : joinNode->projectionVars) {
-    Int ddVar = cnfVarToDdVarMap.at(cnfVar);
-#ifdef MAXIMIZER
-    if (maxsatSolving){
-      Dd term0 = dd.getComposition(ddVar, false, mgr);
-      Dd term1 = dd.getComposition(ddVar, true, mgr);
-      Dd diff = Dd(term1.cuadd - term0.cuadd);
-      Dd Gx = Dd(diff.cuadd.BddThreshold(0).Add());
-      stackMaximizer.push(std::make_pair(ddVar, Gx));
-    }
-#endif
-#ifdef MAXBYPUREBA
-    dd = dd.getAbstractionMaxSATBA(ddVar, ddVarToCnfVarMap, JoinNode::cnf.literalWeights, assignment, JoinNode::cnf.additiveVars.contains(cnfVar), allADDs, mgr);
-#else
-    dd = maxsatSolving ? dd.getAbstractionMaxSAT(ddVar, ddVarToCnfVarMap, JoinNode::cnf.literalWeights, assignment, JoinNode::cnf.additiveVars.contains(cnfVar), mgr) \
-    : dd.getAbstraction(ddVar, ddVarToCnfVarMap, JoinNode::cnf.literalWeights, assignment, JoinNode::cnf.additiveVars.contains(cnfVar), mgr);
-#endif
+void Executor::writeSliceRecord(const string& recordType, const Assignment& assignment, const vector<string>& fields) {
+  string record = recordType;
+  for (const auto& [var, val] : assignment) {
+    record += " " + to_string(val ? var : -var);
   }
-#ifndef MAXBYPUREBA
-  updateVarDurations(joinNode, nonterminalStartPoint);
-  updateVarDdSizes(joinNode, dd);
-  Int numNodes =  dd.countNodes();
-    if ( numNodes > maxOfADDNodes ){
-      maxOfADDNodes = numNodes;
+  record += " 0";
+  for (const string& field : fields) {
+    record += " " + field;
+  }
+  appendCheckpointRecord(record);
+  removeCheckpointFiles(checkpointKey + "_" + getSliceKey(assignment) + "_"); // subtree ADDs are superseded
+}
+
+void Executor::removeCheckpointFiles(const string& filePrefix) {
+  std::error_code errorCode; // other threads may remove files concurrently
+  for (const auto& entry : std::filesystem::directory_iterator(checkpointDir, errorCode)) {
+    if (entry.path().filename().string().starts_with(filePrefix)) {
+      std::filesystem::remove(entry.path(), errorCode);
+    }
   }
-#endif
-  return dd;
 }
 
 Dd test_Walsh(int n, const Cudd* mgr) {
@@ -1062,51 +2792,149 @@ Dd test_Walsh(int n, const Cudd* mgr) {
 
 
 
-void Executor::solveThreadSlices(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Float threadMem, Int threadIndex, const vector<vector<Assignment>>& threadAssignmentLists, Number& totalSolution, mutex& solutionMutex) {
-  const vector<Assignment>& threadAssignments = threadAssignmentLists.at(threadIndex);
-  for (Int threadAssignmentIndex = 0; threadAssignmentIndex < threadAssignments.size(); threadAssignmentIndex++) {
+void Executor::solveThreadSlices(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Float threadMem, Int threadIndex, SliceQueue& sliceQueue, Number& totalSolution, mutex& solutionMutex) {
+  Int sliceThreadCount = sliceQueue.threadDeques.size();
+  bool budgeted = sliceSecondsBudget > 0 || sliceNodesBudget > 0;
+  const Cudd* mgr = ddPackage == CUDD ? Dd::newMgr(threadMem, threadIndex) : nullptr; // reused by all slices of this thread
+  Assignment assignment;
+  for (Int threadSliceIndex = 0; sliceQueue.popSlice(assignment, threadIndex); threadSliceIndex++) {
+    if (threadSliceIndex > 0 && ddPackage == CUDD) {
+      Dd::recycleMgr(mgr); // diagrams of previous slice are dead by now
+    }
     TimePoint sliceStartPoint = util::getTimePoint();
     Int LB = 0;
     stack<pair<int, Dd> > stackMaximizer;
     map<int, Dd> allADDs;
-    const Cudd * mgr = Dd::newMgr(threadMem, threadIndex);
-#ifdef MAXBYPUREBA
-    Dd finalanswer = solveSubtree(static_cast<const JoinNode*>(joinRoot), cnfVarToDdVarMap, ddVarToCnfVarMap, LB, stackMaximizer, allADDs, mgr,  threadAssignments.at(threadAssignmentIndex));
-    Dd sum = Dd::getZeroDd(mgr);
-    for (auto index : finalanswer.setOfADDIndex){
-      sum = sum.getSum(allADDs.find(index)->second);
+    Number partialSolution;
+    Map<Int, Dd> nodeDds; // for maximizer
+    Assignment maximizer;
+    vector<string> record; // from previous run
+    if (!checkpointDir.empty()) {
+      auto it = checkpointRecords.find(getSliceKey(assignment));
+      if (it != checkpointRecords.end()) {
+        record = it->second;
+      }
+    }
+    if (!record.empty() && record.front() == SPLIT_SLICE_RECORD) {
+      if (isAnytime()) {
+        splitPendingSlice(assignment, sliceQueue.getSplitVar(assignment)); // before children can be popped
+      }
+      sliceQueue.splitSlice(assignment, threadIndex);
+      sliceQueue.finishSlice();
+      continue;
+    }
+    if (!record.empty() && record.front() == PRUNED_SLICE_RECORD) {
+      if (isAnytime()) {
+        finishPendingSlice(assignment);
+      }
+      sliceQueue.finishSlice();
+      continue;
+    }
+    if (!record.empty()) { // FINISHED_SLICE_RECORD
+      LB = stoll(record.at(1));
+      partialSolution = Number(record.at(2));
     }
-    Number partialSolution = sum.extractConst();
+    else {
+      try {
+        TimePoint budgetStartPoint = budgeted && sliceQueue.isSplittable(assignment) ? sliceStartPoint : TimePoint();
+#ifdef MAXBYPUREBA
+        Dd finalanswer = solveSubtree(static_cast<const JoinNode*>(joinRoot), cnfVarToDdVarMap, ddVarToCnfVarMap, LB, stackMaximizer, allADDs, mgr, assignment, budgetStartPoint);
+        Dd sum = Dd::getZeroDd(mgr);
+        for (auto index : finalanswer.setOfADDIndex){
+          sum = sum.getSum(allADDs.find(index)->second);
+        }
+        partialSolution = sum.extractConst();
 #else
-    Dd subtreeNode = solveSubtree(static_cast<const JoinNode*>(joinRoot), cnfVarToDdVarMap, ddVarToCnfVarMap, LB, stackMaximizer, allADDs, mgr,  threadAssignments.at(threadAssignmentIndex));
-    Number partialSolution = subtreeNode.extractConst();
+        Dd subtreeNode = solveSubtree(static_cast<const JoinNode*>(joinRoot), cnfVarToDdVarMap, ddVarToCnfVarMap, LB, stackMaximizer, allADDs, mgr, assignment, budgetStartPoint, maximizerSolving ? &nodeDds : nullptr);
+        partialSolution = subtreeNode.extractConst();
+        if (maximizerSolving) {
+          TimePoint maximizerStartPoint = util::getTimePoint();
+          maximizer = getMaximizer(joinRoot, nodeDds, ddVarToCnfVarMap, mgr, assignment);
+          nodeDds.clear();
+          if (verboseSolving >= 1) {
+            const std::lock_guard<mutex> g(solutionMutex);
+            cout << "c thread " << right << setw(4) << threadIndex + 1 << "/" << sliceThreadCount << " | slice " << setw(4) << threadSliceIndex + 1 << " | maximizer seconds " << util::getDuration(maximizerStartPoint) << "\n";
+          }
+        }
 #endif
-    const std::lock_guard<mutex> g(solutionMutex);
-    if (verboseSolving >= 1) {
-      cout << "c thread " << right << setw(4) << threadIndex + 1 << "/" << threadAssignmentLists.size() << " | assignment " << setw(4) << threadAssignmentIndex + 1 << "/" << threadAssignments.size() << ": { ";
-      threadAssignments.at(threadAssignmentIndex).printAssignment();
-      cout << " }\n";
-
-      cout << "c thread " << right << setw(4) << threadIndex + 1 << "/" << threadAssignmentLists.size() << " | assignment " << setw(4) << threadAssignmentIndex + 1 << "/" << threadAssignments.size() << " | seconds " << left << setw(10) << util::getDuration(sliceStartPoint) << (maxsatSolving ? " | mx " : " | mc ") << setw(15);
-      if (logCounting) {
-        cout << exp10l(partialSolution.fraction) << " | log10(mc) " << partialSolution.fraction << "\n";
       }
-      else {
-        cout << partialSolution << "\n";
+      catch (SliceBudgetException) {
+        if (!checkpointDir.empty()) {
+          writeSliceRecord(SPLIT_SLICE_RECORD, assignment);
+        }
+        if (isAnytime()) {
+          splitPendingSlice(assignment, sliceQueue.getSplitVar(assignment)); // before children can be popped
+        }
+        sliceQueue.splitSlice(assignment, threadIndex);
+        sliceQueue.finishSlice();
+        continue;
+      }
+      catch (SliceBoundException) {
+        if (!checkpointDir.empty()) {
+          writeSliceRecord(PRUNED_SLICE_RECORD, assignment, {to_string(LB)});
+        }
+        if (verboseSolving >= 1) {
+          const std::lock_guard<mutex> g(solutionMutex);
+          cout << "c thread " << right << setw(4) << threadIndex + 1 << "/" << sliceThreadCount << " | slice " << setw(4) << threadSliceIndex + 1 << " | pruned at lower bound " << LB << " by incumbent " << incumbentCost << "\n";
+        }
+        if (isAnytime()) {
+          finishPendingSlice(assignment); // its cost is at least the incumbent
+        }
+        sliceQueue.finishSlice();
+        continue;
       }
     }
-    if (maxsatSolving){
-      std::cout<<"c maxsat LB under partial assignment "<<LB<<std::endl;
-        totalSolution = partialSolution < totalSolution.fraction ? partialSolution : totalSolution;
-    }
-    else{
-      totalSolution = logCounting ? Number(totalSolution.getLogSumExp(partialSolution)) : totalSolution + partialSolution;
+    if (!checkpointDir.empty() && record.empty()) {
+      writeSliceRecord(FINISHED_SLICE_RECORD, assignment, {to_string(LB), getCheckpointString(partialSolution)});
     }
-    std::cout<<"c numNodes " << maxOfADDNodes<<std::endl;
+    {
+      const std::lock_guard<mutex> g(solutionMutex);
+      if (verboseSolving >= 1) {
+        cout << "c thread " << right << setw(4) << threadIndex + 1 << "/" << sliceThreadCount << " | slice " << setw(4) << threadSliceIndex + 1 << (record.empty() ? "" : " (checkpointed)") << ": { ";
+        assignment.printAssignment();
+        cout << " }\n";
+
+        cout << "c thread " << right << setw(4) << threadIndex + 1 << "/" << sliceThreadCount << " | slice " << setw(4) << threadSliceIndex + 1 << " | seconds " << left << setw(10) << util::getDuration(sliceStartPoint) << (maxsatSolving ? " | mx " : " | mc ") << setw(15);
+        if (logCounting) {
+          cout << exp10l(partialSolution.fraction) << " | log10(mc) " << partialSolution.fraction << "\n";
+        }
+        else {
+          cout << partialSolution << "\n";
+        }
+      }
+      if (maxsatSolving){
+        std::cout<<"c maxsat LB under partial assignment "<<LB<<std::endl;
+        if (minMaxsatSolving) { // slice vars are additive (min) vars, which are eliminated by max
+          totalSolution = !sliceSolved || totalSolution < partialSolution ? partialSolution : totalSolution;
+        }
+        else { // slice vars are disjunctive vars, which are eliminated by min
+          totalSolution = !sliceSolved || partialSolution < totalSolution ? partialSolution : totalSolution;
+          Float partialCost = multiplePrecision ? partialSolution.quotient.get_d() : partialSolution.fraction;
+          if (partialCost < LLONG_MAX) {
+            updateIncumbentCost(partialCost);
+          }
+          if (maximizerSolving && (!bestMaximizerCost || partialSolution < *bestMaximizerCost)) {
+            bestMaximizer = maximizer;
+            bestMaximizerCost = partialSolution;
+          }
+          finishPendingSlice(assignment); // reports improved bounds
+        }
+        sliceSolved = true;
+      }
+      else{
+        totalSolution = logCounting ? Number(totalSolution.getLogSumExp(partialSolution)) : totalSolution + partialSolution;
+      }
+      std::cout<<"c numNodes " << maxOfADDNodes<<std::endl;
 #ifdef MAXIMIZER
-    printMaximizer(stackMaximizer, ddVarToCnfVarMap, mgr);
+      printMaximizer(stackMaximizer, ddVarToCnfVarMap, mgr);
 #endif
+    }
+    sliceQueue.finishSlice();
   }
+  if (mgr != nullptr) {
+    updatePeak(peakLiveNodeCount, Cudd_ReadPeakLiveNodeCount(mgr->getManager()));
+  }
+  delete mgr;
 }
 
 void Executor::printMaximizer(stack<pair<int,Dd> >& stackMaximizer, const vector<Int>& ddVarToCnfVarMap, const Cudd * mgr){
@@ -1139,71 +2967,77 @@ void Executor::printMaximizer(stack<pair<int,Dd> >& stackMaximizer, const vector
 }
 
 
-vector<vector<Assignment>> Executor::getThreadAssignmentLists(const JoinNonterminal* joinRoot, Int sliceVarOrderHeuristic) {
+vector<Assignment> Executor::getInitialAssignments(const vector<Int>& sliceVarOrder) {
   size_t sliceVarCount = ceill(log2l(threadCount * threadSliceCount));
-  sliceVarCount = min(sliceVarCount, JoinNode::cnf.additiveVars.size());
+  sliceVarCount = min(sliceVarCount, sliceVarOrder.size());
 
-  Int remainingSliceCount = exp2l(sliceVarCount);
-  Int remainingThreadCount = threadCount;
-  vector<Int> threadSliceCounts;
-  while (remainingThreadCount > 0) {
-    Int sliceCount = ceill(static_cast<Float>(remainingSliceCount) / remainingThreadCount);
-    threadSliceCounts.push_back(sliceCount);
-    remainingSliceCount -= sliceCount;
-    remainingThreadCount--;
-  }
-  assert(remainingSliceCount == 0);
+  vector<Assignment> assignments = Assignment::getPrefixAssignments(sliceVarOrder, sliceVarCount);
 
   if (verboseSolving >= 1) {
-    cout << "c thread slice counts: { ";
-    for (Int sliceCount : threadSliceCounts) {
-      cout << sliceCount << " ";
-    }
-    cout << "}\n";
-  }
-
-  vector<Assignment> assignments = joinRoot->getAdditiveAssignments(sliceVarOrderHeuristic, sliceVarCount);
-  vector<vector<Assignment>> threadAssignmentLists;
-  vector<Assignment> threadAssignmentList;
-  for (Int assignmentIndex = 0, threadListIndex = 0; assignmentIndex < assignments.size() && threadListIndex < threadSliceCounts.size(); assignmentIndex++) {
-    threadAssignmentList.push_back(assignments.at(assignmentIndex));
-    if (threadAssignmentList.size() == threadSliceCounts.at(threadListIndex)) {
-      threadAssignmentLists.push_back(threadAssignmentList);
-      threadAssignmentList.clear();
-      threadListIndex++;
-    }
+    util::printRow("initialSliceCount", assignments.size());
   }
 
   if (verboseSolving >= 2) {
-    for (Int threadIndex = 0; threadIndex < threadAssignmentLists.size(); threadIndex++) {
-      const vector<Assignment>& threadAssignments = threadAssignmentLists.at(threadIndex);
-      cout << "c assignments in thread " << right << setw(4) << threadIndex + 1 << ":";
-      for (const Assignment& assignment : threadAssignments) {
-        cout << " { ";
-        assignment.printAssignment();
-        cout << " }";
-      }
-      cout << "\n";
+    cout << "c initial slices:";
+    for (const Assignment& assignment : assignments) {
+      cout << " { ";
+      assignment.printAssignment();
+      cout << " }";
     }
+    cout << "\n";
   }
 
-  return threadAssignmentLists;
+  return assignments;
 }
 
 Number Executor::solveCnf(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Int sliceVarOrderHeuristic) {
-  vector<vector<Assignment>> threadAssignmentLists = getThreadAssignmentLists(joinRoot, sliceVarOrderHeuristic);
-  util::printRow("sliceWidth", joinRoot->getWidth(threadAssignmentLists.front().front())); // any assignment would work
-  Number totalSolution = logCounting ? Number(-INF) : Number();
-  totalSolution = maxsatSolving ? Number(INF) : totalSolution;
+  bool budgeted = sliceSecondsBudget > 0 || sliceNodesBudget > 0;
+  vector<Int> sliceVarOrder;
+  if (ddPackage == CUDD && (threadCount * threadSliceCount > 1 || budgeted)) { // Sylvan parallelizes each operation over threadCount Lace workers instead
+    sliceVarOrder = joinRoot->getSliceVarOrder(sliceVarOrderHeuristic);
+  }
+  vector<Assignment> assignments = getInitialAssignments(sliceVarOrder);
+  util::printRow("sliceWidth", joinRoot->getWidth(assignments.front())); // any assignment would work
+  Number totalSolution = logCounting ? Number(-INF) : Number(); // MaxSAT: replaced by first slice
+  sliceSolved = false;
   mutex solutionMutex;
+  if (maximizerSolving) {
+    bestMaximizerCost.reset();
+  }
+  setChildOrders(joinRoot);
+  peakLiveDiagramCount = 0;
+  peakLiveNodeCount = 0;
+  spillFileCount = 0;
+  if (!checkpointDir.empty()) {
+    std::filesystem::create_directories(checkpointDir);
+    checkpointKey = getCheckpointKey(joinRoot, ddVarToCnfVarMap);
+    readCheckpoint();
+    const std::lock_guard<mutex> g(boundMutex);
+    localSearchCheckpointing = true;
+    writeLocalSearchRecord(); // found during planning
+  }
+
+  if (isAnytime()) {
+    const std::lock_guard<mutex> g(boundMutex);
+    pendingSliceLBs.clear();
+    for (const Assignment& assignment : assignments) {
+      pendingSliceLBs[getSliceKey(assignment)] = 0; // costs are non-negative
+    }
+    slicingStarted = true;
+  }
 
-  Float threadMem = maxMem / threadAssignmentLists.size();
+  Int sliceThreadCount = budgeted && ddPackage == CUDD ? threadCount : min(threadCount, static_cast<Int>(assignments.size())); // split slices may feed extra threads
+  SliceQueue sliceQueue(assignments, sliceVarOrder, sliceThreadCount);
+
+  Float threadMem = maxMem / (sliceThreadCount + subtreeThreadCount);
   util::printRow("threadMaxMemMegabytes", threadMem);
+  idleSubtreeThreadCount = subtreeThreadCount;
+  subtreeThreadMem = threadMem;
 
   vector<thread> threads;
 
   Int threadIndex = 0;
-  for (; threadIndex < threadAssignmentLists.size() - 1; threadIndex++) {
+  for (; threadIndex < sliceThreadCount - 1; threadIndex++) {
     threads.push_back(thread(
       solveThreadSlices,
       std::cref(joinRoot),
@@ -1211,7 +3045,7 @@ Number Executor::solveCnf(const JoinNonterminal* joinRoot, const Map<Int, Int>&
       std::cref(ddVarToCnfVarMap),
       threadMem,
       threadIndex,
-      threadAssignmentLists,
+      std::ref(sliceQueue),
       std::ref(totalSolution),
       std::ref(solutionMutex)
     ));
@@ -1222,13 +3056,46 @@ Number Executor::solveCnf(const JoinNonterminal* joinRoot, const Map<Int, Int>&
     ddVarToCnfVarMap,
     threadMem,
     threadIndex,
-    threadAssignmentLists,
+    sliceQueue,
     totalSolution,
     solutionMutex
   );
   for (thread& t : threads) {
     t.join();
   }
+  if (!localSearchThreads.empty()) {
+    stopLocalSearch();
+  }
+  if (isAnytime() && localSearchCost < LLONG_MAX) { // slices pruned by local-search costs, also of checkpointed runs, did not reach totalSolution
+    Number localSearchSolution(to_string(localSearchCost));
+    totalSolution = !sliceSolved || localSearchSolution < totalSolution ? localSearchSolution : totalSolution;
+    sliceSolved = true;
+    if (maximizerSolving && (!bestMaximizerCost || localSearchSolution <= *bestMaximizerCost)) { // slice ADDs saturated at this cost may decode worse maximizers
+      bestMaximizer = localSearchModel; // maximizers exclude checkpointing, so this cost was found in this run
+      bestMaximizerCost = localSearchSolution;
+    }
+  }
+  if (maxsatSolving && !sliceSolved) { // slices are pruned only by costs that reach totalSolution
+    throw MyError("all slices were pruned without a known cost");
+  }
+  for (const Cudd* subtreeMgr : idleSubtreeMgrs) {
+    updatePeak(peakLiveNodeCount, Cudd_ReadPeakLiveNodeCount(subtreeMgr->getManager()));
+    delete subtreeMgr;
+  }
+  idleSubtreeMgrs.clear();
+  if (!checkpointDir.empty()) { // nothing left to resume
+    removeCheckpointFiles(checkpointKey);
+  }
+
+  if (verboseSolving >= 1) {
+    util::printRow("peakLiveDiagramCount", peakLiveDiagramCount);
+    if (!spillDir.empty()) {
+      util::printRow("spilledDiagramCount", spillFileCount);
+    }
+    if (ddPackage == CUDD) {
+      util::printRow("peakLiveNodeCount", peakLiveNodeCount); // max over managers
+    }
+  }
 
   return totalSolution;
 }
@@ -1321,7 +3188,7 @@ void Executor::printSolutionRows(const Number& solution, bool surelyUnsat, size_
   if(!maxsatSolving)
     std::cout<<"solution before adjustment: "<<solution.fraction<<std::endl;
 
-  Number n = maxsatSolving ? solution : adjustSolution(solution);
+  Number n = maxsatSolving ? solution + Number(to_string(JoinNode::cnf.costOffset)) : adjustSolution(solution); // offset of preprocessed MaxSAT formula
 
   printSatRow(n, surelyUnsat, keyWidth);
   printTypeRow(keyWidth);
@@ -1355,15 +3222,29 @@ Executor::Executor(const JoinNonterminal* joinRoot, Int ddVarOrderHeuristic, Int
     cnfVarToDdVarMap[cnfVar] = ddVar;
   }
 
+  Dd::setAbstractionWeights(ddVarToCnfVarMap);
+
   Number n = solveCnf(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, sliceVarOrderHeuristic);
   printVarDurations();
   printVarDdSizes();
+  printReorderingStats();
+  if (verboseSolving >= 1 && maxsatSolving) {
+    util::printRow("hardenedConstraintCount", hardenedConstraintCount);
+  }
+  if (verboseSolving >= 1 && localSearchThreadCount > 0 && isAnytime()) {
+    util::printRow("localSearchCost", localSearchCost < LLONG_MAX ? to_string(localSearchCost + JoinNode::cnf.costOffset) : "NONE");
+  }
 
   if (verboseSolving >= 1 && !maxsatSolving) {
     util::printRow("apparentSolution", logCounting ? exp10l(n.fraction) : n);
   }
-  if (maxsatSolving)
-    std::cout<<"o "<< (Int) n.fraction << std::endl;
+  finishSolving();
+  Int cost = multiplePrecision ? n.quotient.get_d() : n.fraction;
+  if (maxsatSolving && cost < reportedUB) // not streamed yet
+    std::cout<<"o "<< cost + JoinNode::cnf.costOffset << std::endl;
+  if (maximizerSolving && bestMaximizerCost) {
+    printMaximizerRow(bestMaximizer);
+  }
   printSolutionRows(n);
 }
 
@@ -1380,6 +3261,17 @@ string OptionDict::helpDdPackage() {
   return s + "; string";
 }
 
+string OptionDict::helpDdReordering() {
+  string s = "diagram var reordering between joins" + util::useDdPackage(CUDD) + ": ";
+  for (auto it = REORDERING_METHODS.begin(); it != REORDERING_METHODS.end(); it++) {
+    s += it->first + "/" + it->second;
+    if (next(it) != REORDERING_METHODS.end()) {
+      s += ", ";
+    }
+  }
+  return s + "; string";
+}
+
 string OptionDict::helpJoinPriority() {
   string s = "join priority: ";
   for (auto it = JOIN_PRIORITIES.begin(); it != JOIN_PRIORITIES.end(); it++) {
@@ -1410,11 +3302,27 @@ void OptionDict::runCommand() const {
 
     if (ddPackage == CUDD) {
       util::printRow("threadSliceCount", threadSliceCount);
+      util::printRow("sliceSecondsBudget", sliceSecondsBudget);
+      util::printRow("sliceNodesBudget", sliceNodesBudget);
+      util::printRow("subtreeThreadCount", subtreeThreadCount);
+      util::printRow("spillDir", spillDir.empty() ? "NONE" : spillDir);
+    }
+
+    if (maxsatSolving) {
+      util::printRow("localSearchThreadCount", localSearchThreadCount);
+    }
+
+    util::printRow("maximizer", maximizerSolving);
+    util::printRow("deadlineSeconds", deadlineSeconds);
+
+    util::printRow("checkpointDir", checkpointDir.empty() ? "NONE" : checkpointDir);
+    if (!checkpointDir.empty()) {
+      util::printRow("checkpointSeconds", checkpointSeconds);
     }
 
     util::printRow("randomSeed", randomSeed);
 
-    util::printRow("diagramVarOrder", (ddVarOrderHeuristic < 0 ? "INVERSE_" : "") + CNF_VAR_ORDER_HEURISTICS.at(abs(ddVarOrderHeuristic)));
+    util::printRow("diagramVarOrder", (ddVarOrderHeuristic < 0 ? "INVERSE_" : "") + util::getVarOrderHeuristics().at(abs(ddVarOrderHeuristic)));
 
     if (ddPackage == CUDD) {
       util::printRow("sliceVarOrder", (sliceVarOrderHeuristic < 0 ? "INVERSE_" : "") + util::getVarOrderHeuristics().at(abs(sliceVarOrderHeuristic)));
@@ -1433,18 +3341,38 @@ void OptionDict::runCommand() const {
     }
 
     util::printRow("joinPriority", JOIN_PRIORITIES.at(joinPriority));
+
+    if (ddPackage == CUDD) {
+      util::printRow("diagramReordering", REORDERING_METHODS.at(reorderingMethod));
+      if (reorderingMethod != NO_REORDERING) {
+        util::printRow("reorderingGrowth", reorderingGrowth);
+        util::printRow("reorderingSecondsBudget", reorderingSecondsBudget);
+      }
+    }
     cout << "\n";
   }
 
   try {
     JoinNode::cnf = Cnf(cnfFilePath);
+    if (maximizerSolving && !Executor::isAnytime()) { // min vars are only known from cnf
+      throw MyError("maximizer needs plain MaxSAT");
+    }
+
+    if (maxsatSolving || deadlineSeconds > 0) {
+      Executor::startWatchdog();
+    }
 
     if (JoinNode::cnf.clauses.empty()) {
       cout << WARNING << "empty cnf\n";
-      Executor::printSolutionRows(logCounting ? Number() : Number("1"));
+      Executor::finishSolving();
+      Executor::printSolutionRows(logCounting || maxsatSolving ? Number() : Number("1")); // no cost for MaxSAT
       return;
     }
 
+    if (localSearchThreadCount > 0 && Executor::isAnytime()) {
+      Executor::startLocalSearch(); // runs while join tree is planned and read
+    }
+
     JoinTreeProcessor* joinTreeProcessor = planningStrategy == FIRST_JOIN_TREE ? static_cast<JoinTreeProcessor*>(new JoinTreeParser()) : static_cast<JoinTreeProcessor*>(new JoinTreeReader(plannerWaitDuration));
 
     if (ddPackage == SYLVAN) { // initializes Sylvan
@@ -1466,6 +3394,7 @@ void OptionDict::runCommand() const {
     }
   }
   catch (EmptyClauseException) {
+    Executor::finishSolving();
     Executor::printSolutionRows(logCounting ? Number(-INF) : Number(), true);
   }
 }
@@ -1483,6 +3412,15 @@ OptionDict::OptionDict(int argc, char** argv) {
     (DD_PACKAGE_OPTION, helpDdPackage(), value<string>()->default_value(CUDD))
     (THREAD_COUNT_OPTION, "thread count, or 0 for hardware_concurrency value; int", value<Int>()->default_value("1"))
     (THREAD_SLICE_COUNT_OPTION, "thread slice count" + util::useDdPackage(CUDD) + "; int", value<Int>()->default_value("1"))
+    (SLICE_SECONDS_OPTION, "slice seconds budget before splitting slice" + util::useDdPackage(CUDD) + ", or 0 for no limit; float", value<Float>()->default_value("0"))
+    (SLICE_NODES_OPTION, "slice diagram-size budget before splitting slice" + util::useDdPackage(CUDD) + ", or 0 for no limit; int", value<Int>()->default_value("0"))
+    (SUBTREE_THREAD_COUNT_OPTION, "extra thread count for sibling join subtrees" + util::useDdPackage(CUDD) + "; int", value<Int>()->default_value("0"))
+    (SPILL_DIR_OPTION, "scratch dir for spilling ADDs near memory limit" + util::useDdPackage(CUDD) + ", or empty for no spilling; string", value<string>()->default_value(""))
+    (LOCAL_SEARCH_OPTION, "extra thread count for local search feeding upper bounds to ADD pruning (on spare cores beyond tc_arg) [with mx_arg = 1]; int", value<Int>()->default_value("0"))
+    (MAXIMIZER_OPTION, "maximizer for MaxSAT, decoded from cached join-node ADDs: 0, 1; int", value<Int>()->default_value("0"))
+    (DEADLINE_OPTION, "deadline (in seconds since start) for exiting with best known bounds, or 0 for no deadline; float", value<Float>()->default_value("0"))
+    (CHECKPOINT_DIR_OPTION, "checkpoint dir for resuming interrupted run, or empty for no checkpointing; string", value<string>()->default_value(""))
+    (CHECKPOINT_SECONDS_OPTION, "min seconds between subtree ADD checkpoints of a slice" + util::useDdPackage(CUDD) + "; float", value<Float>()->default_value("60"))
     (RANDOM_SEED_OPTION, "random seed; int", value<Int>()->default_value("0"))
     (DD_VAR_OPTION, util::helpVarOrderHeuristic("diagram"), value<Int>()->default_value(to_string(MCS)))
     (SLICE_VAR_OPTION, util::helpVarOrderHeuristic("slice"), value<Int>()->default_value(to_string(BIGGEST_NODE)))
@@ -1493,6 +3431,9 @@ OptionDict::OptionDict(int argc, char** argv) {
     (MULTIPLE_PRECISION_OPTION, "multiple precision" + util::useDdPackage(SYLVAN) + ": 0, 1; int", value<Int>()->default_value("0"))
     (LOG_COUNTING_OPTION, "log counting" + util::useDdPackage(CUDD) + ": 0, 1; int", value<Int>()->default_value("0"))
     (JOIN_PRIORITY_OPTION, helpJoinPriority(), value<string>()->default_value(SMALLEST_PAIR))
+    (DD_REORDERING_OPTION, helpDdReordering(), value<string>()->default_value(NO_REORDERING))
+    (REORDERING_GROWTH_OPTION, "join-result growth factor since last reordering that triggers reordering; float", value<Float>()->default_value("2"))
+    (REORDERING_SECONDS_OPTION, "total reordering seconds budget; float", value<Float>()->default_value("60"))
     (VERBOSE_CNF_OPTION, "verbose cnf: 0, " + INPUT_VERBOSITIES, value<Int>()->default_value("0"))
     (VERBOSE_JOIN_TREE_OPTION, "verbose join tree: 0, " + INPUT_VERBOSITIES, value<Int>()->default_value("0"))
     (VERBOSE_PROFILING_OPTION, "verbose profiling: 0, 1, 2; int", value<Int>()->default_value("0"))
@@ -1522,10 +3463,42 @@ OptionDict::OptionDict(int argc, char** argv) {
     threadSliceCount = result[THREAD_SLICE_COUNT_OPTION].as<Int>(); // global var
     assert(threadSliceCount > 0);
 
+    sliceSecondsBudget = result[SLICE_SECONDS_OPTION].as<Float>(); // global var
+    sliceNodesBudget = result[SLICE_NODES_OPTION].as<Int>(); // global var
+    assert(sliceSecondsBudget >= 0 && sliceNodesBudget >= 0);
+
+    subtreeThreadCount = result[SUBTREE_THREAD_COUNT_OPTION].as<Int>(); // global var
+    assert(subtreeThreadCount >= 0);
+
+    spillDir = result[SPILL_DIR_OPTION].as<string>(); // global var
+
+    localSearchThreadCount = result[LOCAL_SEARCH_OPTION].as<Int>(); // global var
+    assert(localSearchThreadCount >= 0);
+
+    maximizerSolving = result[MAXIMIZER_OPTION].as<Int>(); // global var
+#ifdef MAXBYPUREBA
+    assert(!maximizerSolving);
+#endif
+
+    deadlineSeconds = result[DEADLINE_OPTION].as<Float>(); // global var
+    assert(deadlineSeconds >= 0);
+
+    checkpointDir = result[CHECKPOINT_DIR_OPTION].as<string>(); // global var
+    checkpointSeconds = result[CHECKPOINT_SECONDS_OPTION].as<Float>(); // global var
+    assert(checkpointSeconds >= 0);
+#ifdef MAXIMIZER
+    bool keepingMaximizers = true;
+#else
+    bool keepingMaximizers = maximizerSolving;
+#endif
+    if (keepingMaximizers && !checkpointDir.empty()) {
+      throw MyError("checkpointed slices would lose their maximizers");
+    }
+
     randomSeed = result[RANDOM_SEED_OPTION].as<Int>(); // global var
 
     ddVarOrderHeuristic = result[DD_VAR_OPTION].as<Int>();
-    assert(CNF_VAR_ORDER_HEURISTICS.contains(abs(ddVarOrderHeuristic)));
+    assert(CNF_VAR_ORDER_HEURISTICS.contains(abs(ddVarOrderHeuristic)) || abs(ddVarOrderHeuristic) == LAST_ELIMINATED); // other join-tree orders may miss vars
 
     sliceVarOrderHeuristic = result[SLICE_VAR_OPTION].as<Int>();
     assert(util::getVarOrderHeuristics().contains(abs(sliceVarOrderHeuristic)));
@@ -1545,11 +3518,17 @@ OptionDict::OptionDict(int argc, char** argv) {
     joinPriority = result[JOIN_PRIORITY_OPTION].as<string>(); //global var
     assert(JOIN_PRIORITIES.contains(joinPriority));
 
+    reorderingMethod = result[DD_REORDERING_OPTION].as<string>(); // global var
+    assert(REORDERING_METHODS.contains(reorderingMethod));
+    reorderingGrowth = result[REORDERING_GROWTH_OPTION].as<Float>(); // global var
+    assert(reorderingGrowth >= 1);
+    reorderingSecondsBudget = result[REORDERING_SECONDS_OPTION].as<Float>(); // global var
+
     verboseCnf = result[VERBOSE_CNF_OPTION].as<Int>(); // global var
     verboseJoinTree = result[VERBOSE_JOIN_TREE_OPTION].as<Int>(); // global var
 
     verboseProfiling = result[VERBOSE_PROFILING_OPTION].as<Int>(); // global var
-    assert(verboseProfiling <= 0 || threadCount == 1);
+    assert(verboseProfiling <= 0 || (threadCount == 1 && subtreeThreadCount == 0)); // profiling maps are unguarded
 
     verboseSolving = result[VERBOSE_SOLVING_OPTION].as<Int>(); // global var
 
@@ -2,9 +2,21 @@
 
 /* inclusions =============================================================== */
 
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <stack>
 #include <thread>         // std::thread
+#include <tuple>
+#include <unistd.h> // getpid
 
 #include "../libraries/cudd/cplusplus/cuddObj.hh"
 #include "../libraries/cudd/cudd/cuddInt.h"
@@ -18,17 +30,30 @@
 
 /* uses ===================================================================== */
 
+using std::deque;
 using std::stack;
+using std::tuple;
 
+using sylvan::gmp_abstract_op_max_CALL;
+using sylvan::gmp_abstract_op_min_CALL;
 using sylvan::gmp_op_max_CALL;
+using sylvan::gmp_op_min_CALL;
+using sylvan::gmp_op_minus_CALL;
 using sylvan::gmp_op_plus_CALL;
 using sylvan::gmp_op_times_CALL;
+using sylvan::mtbdd_abstract_CALL;
+using sylvan::mtbdd_abstract_op_max_CALL;
+using sylvan::mtbdd_abstract_op_min_CALL;
 using sylvan::mtbdd_apply_CALL;
 using sylvan::mtbdd_fprintdot_nc;
 using sylvan::mtbdd_getdouble;
+using sylvan::mtbdd_gethigh;
+using sylvan::mtbdd_getlow;
 using sylvan::mtbdd_getvalue;
 using sylvan::mtbdd_gmp;
+using sylvan::mtbdd_isleaf;
 using sylvan::mtbdd_makenode;
+using sylvan::MTBDD;
 using sylvan::Mtbdd;
 
 using cxxopts::value;
@@ -36,6 +61,16 @@ using cxxopts::value;
 /* consts =================================================================== */
 
 const Float MEGA = 1e6; // same as countAntom (1 MB = 1e6 B)
+const ptruint DD_ADD_BOUNDED_PLUS_TAG = 0xa2; // cuddInt.h: tags of 3-operand cache entries are 4k+2, highest used is 0x9e
+const ptruint DD_ADD_JOIN_ABSTRACT_TAG = 0xa6;
+const Float SPILL_MEM_FRACTION = 0.8; // of soft memory limit of manager
+const Int SPILL_MIN_NODE_COUNT = 64; // smaller ADDs are not worth a file
+const Int PB_INTERVAL_INF = LLONG_MAX / 4; // open end of PB interval, safe to add coefs to
+const Int SUBTREE_TASK_MIN_WIDTH = 8; // narrower subtrees are cheaper to solve than to give a new manager
+const Int LOCAL_SEARCH_SAMPLE_COUNT = 15; // candidate vars per step (best from multiple selections)
+const Int LOCAL_SEARCH_HARD_WEIGHT_INCREMENT = 3;
+const Int LOCAL_SEARCH_SOFT_WEIGHT_LIMIT = 1000; // soft constraints keep their original weights, scaled down to at most this
+const Float LOCAL_SEARCH_SMOOTHING_PROBABILITY = 0.01; // of lowering weights of satisfied hard constraints instead of raising weights of falsified ones
 
 const string WEIGHTED_COUNTING_OPTION = "wc";
 const string MAXSAT_OPTION = "mx";
@@ -43,6 +78,15 @@ const string MAXSAT_BOUND_OPTION = "mb";
 const string PLANNER_WAIT_OPTION = "pw";
 const string THREAD_COUNT_OPTION = "tc";
 const string THREAD_SLICE_COUNT_OPTION = "ts";
+const string SLICE_SECONDS_OPTION = "ss";
+const string SLICE_NODES_OPTION = "sn";
+const string SUBTREE_THREAD_COUNT_OPTION = "st";
+const string SPILL_DIR_OPTION = "sd";
+const string LOCAL_SEARCH_OPTION = "ls";
+const string CHECKPOINT_DIR_OPTION = "cd";
+const string CHECKPOINT_SECONDS_OPTION = "cs";
+const string DEADLINE_OPTION = "dl";
+const string MAXIMIZER_OPTION = "mz";
 const string DD_VAR_OPTION = "dv";
 const string SLICE_VAR_OPTION = "sv";
 const string MEM_SENSITIVITY_OPTION = "ms";
@@ -52,6 +96,9 @@ const string INIT_RATIO_OPTION = "ir";
 const string MULTIPLE_PRECISION_OPTION = "mp";
 const string LOG_COUNTING_OPTION = "lc";
 const string JOIN_PRIORITY_OPTION = "jp";
+const string DD_REORDERING_OPTION = "dr";
+const string REORDERING_GROWTH_OPTION = "rg";
+const string REORDERING_SECONDS_OPTION = "rt";
 const string VERBOSE_JOIN_TREE_OPTION = "vj";
 const string VERBOSE_PROFILING_OPTION = "vp";
 
@@ -65,12 +112,29 @@ const map<string, string> PLANNING_STRATEGIES = {
 const string ARBITRARY_PAIR = "a";
 const string BIGGEST_PAIR = "b";
 const string SMALLEST_PAIR = "s";
+const string CHEAPEST_PAIR = "c";
 const map<string, string> JOIN_PRIORITIES = {
   {ARBITRARY_PAIR, "ARBITRARY_PAIR"},
   {BIGGEST_PAIR, "BIGGEST_PAIR"},
-  {SMALLEST_PAIR, "SMALLEST_PAIR"}
+  {SMALLEST_PAIR, "SMALLEST_PAIR"},
+  {CHEAPEST_PAIR, "CHEAPEST_PAIR"}
 };
 
+const string NO_REORDERING = "n";
+const string SIFTING = "s";
+const string WINDOW_PERMUTATION = "w";
+const map<string, string> REORDERING_METHODS = {
+  {NO_REORDERING, "NO_REORDERING"},
+  {SIFTING, "SIFTING"},
+  {WINDOW_PERMUTATION, "WINDOW_PERMUTATION"}
+};
+const Int REORDERING_MIN_NODE_COUNT = 1 << 12; // smaller join results never trigger reordering
+
+const string FINISHED_SLICE_RECORD = "f"; // "f {literals} 0 {LB} {solution}"
+const string PRUNED_SLICE_RECORD = "p"; // "p {literals} 0 {LB}"
+const string SPLIT_SLICE_RECORD = "x"; // "x {literals} 0"
+const string LOCAL_SEARCH_RECORD = "l"; // "l 0 {cost}": PRUNED_SLICE_RECORD may rely on it
+
 /* global vars ============================================================== */
 
 extern Int dotFileIndex;
@@ -79,9 +143,21 @@ extern string planningStrategy;
 extern string ddPackage;
 extern Int threadCount;
 extern Int threadSliceCount; // may be lower or higher than actual number of slices per thread
+extern Float sliceSecondsBudget; // a slice running longer is split (0 for no limit)
+extern Int sliceNodesBudget; // a slice whose ADD grows larger is split (0 for no limit)
+extern Int subtreeThreadCount; // extra threads for sibling join subtrees, shared by all slices
+extern string spillDir; // scratch directory for parked ADDs near memory limit (empty for no spilling)
+extern Int localSearchThreadCount; // extra threads whose plain-MaxSAT models give upper bounds for pruning (0 for none)
+extern string checkpointDir; // for resuming interrupted runs (empty for no checkpointing)
+extern Float checkpointSeconds; // min interval between subtree ADD checkpoints of a slice
+extern Float deadlineSeconds; // since tool start; exits with best known bounds (0 for no deadline)
+extern bool maximizerSolving; // plain MaxSAT: decodes optimal assignment from cached node ADDs
 extern Float memSensitivity; // in MB (1e6 B)
 extern Float maxMem; // in MB (1e6 B)
 extern string joinPriority;
+extern string reorderingMethod; // CUDD: between joins
+extern Float reorderingGrowth; // join result this many times bigger than after last reordering of its manager triggers reordering
+extern Float reorderingSecondsBudget; // total over all managers
 extern Int verboseJoinTree; // 1: parsed join tree, 2: raw join tree too
 extern Int verboseProfiling; // 1: sorted stats for cnf vars, 2: unsorted stats for join nodes too
 /* classes for processing join trees ======================================== */
@@ -150,30 +226,63 @@ public:
   ADD cuadd; // CUDD
   Mtbdd mtbdd; // Sylvan
 
+  // stats cached on first use (diagrams are immutable) and shared by copies:
+  mutable Int nodeCount = -1;
+  mutable Float minValue = NAN;
+  mutable Float maxValue = NAN;
+  mutable Int leafCount = -1;
+  mutable std::shared_ptr<const Set<Int>> support;
+
   Dd(const ADD& cuadd); // CUDD
   Dd(const Mtbdd& mtbdd); // SYLVAN
   Dd(const Dd& dd);
 
   static const Cudd* newMgr(Float mem, Int threadIndex); // CUDD
+  static void recycleMgr(const Cudd* mgr); // CUDD: frees dead nodes but keeps table sizes for next slice
   static Dd getConstDd(const Number& n, const Cudd* mgr);
+  static Dd getIntDd(Int n, const Cudd* mgr); // not log-scaled, for costs and parities
   static Dd getZeroDd(const Cudd* mgr);
   static Dd getOneDd(const Cudd* mgr);
   static Dd getVarDd(Int ddVar, bool val, const Cudd* mgr);
+  static Dd getNodeDd(Int ddVar, const Dd& thenDd, const Dd& elseDd, const Cudd* mgr); // children must lie below ddVar in diagram order
   size_t countNodes() const;
   bool operator<(const Dd& rightDd) const; // *this < rightDd (top of priotity queue is rightmost element)
   Number extractConst() const;
   Dd getComposition(Int ddVar, bool val, const Cudd* mgr) const; // restricts *this to ddVar=val
+  Dd getComplement(const Cudd* mgr) const; // *this must be 0-1
+  Dd getIte(const Dd& thenDd, const Dd& elseDd, const Cudd* mgr) const; // *this must be 0-1
+  static ADD getTransferredNode(DdNode* node, const Cudd* destMgr, Map<DdNode*, ADD>& transferredNodes);
+  Dd getTransfer(const Cudd* destMgr) const; // copies *this into destMgr, whose var order may differ
   Dd getProduct(const Dd& dd) const;
   Dd getSum(const Dd& dd) const;
   Dd getXOR(const Dd& dd) const;
   Dd getSubtraction(const Dd& dd) const;
   Dd getThreshold(Int threshold, const Cudd* mgr) const;
+  static DdNode* getBoundedSumNode(DdManager* manager, DdNode* f, DdNode* g, DdNode* bound); // CUDD: NULL if reordering or out of memory
+  Dd getBoundedSum(const Dd& dd, Int bound, const Cudd* mgr) const; // getSum then getThreshold, without building terminals above bound
+  static vector<Float> ddVarNegativeWeights; // literal weights by ddVar, for abstraction kernels
+  static vector<Float> ddVarPositiveWeights;
+  static vector<bool> ddVarAdditivity;
+  static void setAbstractionWeights(const vector<Int>& ddVarToCnfVarMap);
+  static ADD getCubeAdd(const vector<Int>& ddVars, Float leaf, const Cudd* mgr); // leaf value is carried in cache keys
+  static DdNode* getWeightedNode(DdManager* manager, DdNode* node, Float weight); // CUDD: unreferenced node * weight
+  static DdNode* getJoinAbstractionNode(DdManager* manager, DdNode* f, DdNode* g, DdNode* cube); // CUDD: NULL if reordering or out of memory
+  Dd getJoinAbstraction( // joins *this with dd and abstracts ddVars in one pass (CUDD, not logCounting)
+    const Dd& dd,
+    const vector<Int>& ddVars, // unassigned
+    Int bound, // MaxSAT pruning bound
+    const Cudd* mgr
+  ) const;
+  Dd getCubeAbstraction(const vector<Int>& ddVars, Int bound, const Cudd* mgr) const; // abstracts ddVars (unassigned) in one pass
   vector<Int> setOfADDIndex;
   Float getMaxValue() const; // returh the constant node with largest value
-  Float getMinValue() const; // returh the constant node with largest value
+  Float getMinValue() const; // returh the constant node with smallest value
+  Int countLeaves() const;
+  void cacheLeafStats() const; // Sylvan: min, max and count of leaves in one traversal
+  Float getJoinCost(const Dd& dd) const; // predicted log2 node count of joined ADD
   Dd getMax(const Dd& dd) const; // real max (not 0-1 max)
   Dd getMin(const Dd& dd) const;
-  Set<Int> getSupport() const;
+  const Set<Int>& getSupport() const;
   Dd getAbstraction(
     Int ddVar,
     const vector<Int>& ddVarToCnfVarMap,
@@ -198,10 +307,109 @@ public:
     bool additive,
     map<int,Dd> &allADDs,
     const Cudd* mgr) const;
+  void writeAddFile(const string& filePath) const; // CUDD
+  static Dd readAddFile(const string& filePath, const Cudd* mgr); // CUDD
   void writeDotFile(const Cudd* mgr, string dotFileDir = "./") const;
   static void writeInfoFile(const Cudd* mgr, string filePath);
 };
 
+class JoinQueue { // child ADDs of a join node, popped in pairs by joinPriority (not ARBITRARY_PAIR)
+public:
+  std::priority_queue<Dd> sizeQueue; // BIGGEST_PAIR, SMALLEST_PAIR
+  Map<Int, Dd> liveDds; // CHEAPEST_PAIR: push index |-> ADD not yet popped
+  Int pushCount = 0; // CHEAPEST_PAIR
+  std::priority_queue<std::tuple<Float, Int, Int>, vector<std::tuple<Float, Int, Int>>, greater<std::tuple<Float, Int, Int>>> pairQueue; // CHEAPEST_PAIR: (cost, index1, index2), possibly stale
+
+  JoinQueue(const vector<Dd>& childDdList);
+  size_t size() const;
+  void push(const Dd& dd);
+  pair<Dd, Dd> popPair();
+  Dd popLast(); // size() == 1
+};
+
+/* classes for scheduling slices ============================================ */
+
+class SliceBudgetException : public std::exception {}; // thrown when a slice exceeds its time or ADD-size budget
+class SliceBoundException : public std::exception {}; // thrown when a slice cannot beat the incumbent cost
+
+class SliceQueue { // work-stealing queue of slice assignments shared by all threads
+public:
+  vector<Int> sliceVarOrder; // vars to condition on, most preferred first
+  vector<deque<Assignment>> threadDeques; // each thread pops from the back of its own deque and steals from the front of others
+  Int pendingSliceCount = 0; // queued or running slices
+  mutex queueMutex;
+  std::condition_variable queueCondition;
+
+  bool isSplittable(const Assignment& assignment) const; // some slice var is unassigned
+  void pushSlice(const Assignment& assignment, Int threadIndex);
+  bool popSlice(Assignment& assignment, Int threadIndex); // waits for work; returns false once all slices are finished
+  void finishSlice();
+  Int getSplitVar(const Assignment& assignment) const; // next unassigned slice var
+  void splitSlice(const Assignment& assignment, Int threadIndex); // conditions on next slice var
+
+  SliceQueue(const vector<Assignment>& assignments, const vector<Int>& sliceVarOrder, Int threadCount);
+};
+
+class SubtreeTask { // join subtree solved by a worker thread in its own manager
+public:
+  const JoinNode* joinNode;
+  const Cudd* mgr;
+  Int LB = 0;
+  Dd* dd = nullptr; // in mgr
+  std::exception_ptr exception;
+  thread worker;
+
+  SubtreeTask(const JoinNode* joinNode, const Cudd* mgr);
+};
+
+class SubtreeFrame { // join node on the explicit stack of Executor::solveSubtree
+public:
+  const JoinNode* joinNode;
+  vector<JoinNode*> childOrder;
+  Int childIndex = 0; // next child to solve
+  const JoinNode* lastNonterminalChild = nullptr; // solved by this thread so that it does not idle while workers run
+  vector<Dd> childDdList;
+  vector<string> spillFilePaths; // child ADDs written to disk
+  vector<SubtreeTask> subtreeTasks;
+
+  SubtreeFrame(const JoinNode* joinNode);
+};
+
+class LocalSearcher { // SATLike-style search with dynamic constraint weights, in its own thread
+public:
+  vector<char> types; // constraint |-> 'c', 'x', or 'p' as in Cnf
+  vector<vector<pair<Int, Int>>> constraintTerms; // constraint |-> (literal, coef), where coef is 1 for clause or XOR
+  vector<Int> comparators; // >= (1) or = (2) for PB
+  vector<Int> rhses; // for PB
+  vector<Int> weights; // original
+  vector<bool> hardConstraints; // weight reaches trivial bound
+  vector<vector<tuple<Int, Int, Int>>> varTerms; // var |-> (constraint, literal, coef), grouped by constraint
+  vector<Int> constraintSums; // true literals of clause or XOR, or coef sum of true literals of PB
+  vector<Int> dynamicWeights; // hard: raised when falsified at local optima; soft: scaled original weight
+  vector<Int> falsifiedHardConstraints;
+  vector<Int> falsifiedSoftConstraints;
+  vector<Int> falsifiedPositions; // constraint |-> index in falsifiedHardConstraints or falsifiedSoftConstraints, or MIN_INT
+  Int softCost = 0; // original weights of falsified soft constraints, as in ADD leaves
+  bool infeasible = false; // some hard constraint without literals is falsified
+  vector<bool> vals; // var |-> val
+  vector<Int> flipSteps; // var |-> step of last flip, for preferring vars flipped longest ago
+  Int step = 0;
+  Int lastFlippedVar = MIN_INT;
+  std::mt19937_64 generator;
+
+  bool isTrue(Int literal) const;
+  bool isFalsified(Int constraint, Int sum) const;
+  void setFalsified(Int constraint, bool falsified);
+  Int getScore(Int var) const; // decrease in dynamic weight of falsified constraints if var is flipped
+  void flipVar(Int var);
+  void updateWeights(); // at local optimum
+  Int pickFalsifiedConstraint(); // hard first
+  Int pickVar();
+  void search(); // until Executor::localSearchStopping, reporting improved models to Executor
+
+  LocalSearcher(const Cnf& cnf, Int seed);
+};
+
 class Executor {
 public:
   static Map<Int, Float> varDurations; // cnfVar |-> total execution time in seconds
@@ -210,25 +418,75 @@ public:
   static void updateVarDdSizes(const JoinNode* joinNode, const Dd& dd);
   static void printVarDurations();
   static void printVarDdSizes();
-  static Dd getClauseDd(
+  static Int getDdVarLevel(Int ddVar, const Cudd* mgr); // adds ddVar to CUDD manager
+  static Dd getClauseDd( // OR of literals, built bottom-up in one pass
     const Map<Int, Int>& cnfVarToDdVarMap,
     const Clause& clause,
+    const Dd& trueDd, // leaf of satisfied constraint
+    const Dd& falseDd,
     const Cudd* mgr,
     const Assignment& assignment
   );
   static Dd getClauseSDd(const Map<Int, Int>& cnfVarToDdVarMap, const Clause& clause, const Cudd* mgr, const Assignment& assignment);
-  static Dd getXORDd(
+  static Dd getXORDd( // odd parity of literals, built bottom-up in one pass
     const Map<Int, Int>& cnfVarToDdVarMap,
     const Clause& clause,
+    const Dd& trueDd, // leaf of satisfied constraint
+    const Dd& falseDd,
+    const Cudd* mgr,
+    const Assignment& assignment
+  );
+  static tuple<Int, Int, Dd> getPBIntervalDd( // (lower, upper, node): all rhs values in [lower, upper] give the same node
+    Int termIndex,
+    Int rhs, // still to be reached by terms from termIndex onward
+    const vector<tuple<Int, bool, Int>>& terms, // (ddVar, val, coef), top var first
+    const vector<Int>& suffixCoefSums,
+    Int comparator,
+    vector<map<Int, pair<Int, Dd>>>& intervalLayers, // termIndex |-> lower |-> (upper, node)
+    const Dd& trueDd,
+    const Dd& falseDd,
+    const Cudd* mgr
+  );
+  static Dd getPBDd( // merges equivalent partial sums into intervals (BDD-based PB encoding)
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const Map<Int, Int>& coefs, // literal |-> positive coef
+    Int comparator, // >= (1) or = (2)
+    Int rhs,
+    const Dd& trueDd, // leaf of satisfied constraint
+    const Dd& falseDd,
     const Cudd* mgr,
     const Assignment& assignment
   );
-  static Dd getPBDd(const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int> clause,
-      Map<Int,Int> coefs, const int comparator,
-      const int rhs, int size, Int sum,
-      Int material_left,
-      std::map<pair<Int, Int>, Dd>& hashing,
-      const Cudd* mgr, const Assignment& assignment);
+  static Map<Int, vector<JoinNode*>> childOrders; // nonterminal nodeIndex |-> children in solving order
+  static std::atomic<Int> peakLiveDiagramCount; // child ADDs held at once by one thread
+  static std::atomic<Int> peakLiveNodeCount; // CUDD
+  static void setChildOrders(const JoinNonterminal* joinRoot);
+  static void updatePeak(std::atomic<Int>& peak, Int value);
+  static std::atomic<Int> spillFileCount;
+  static bool isNearMemLimit(const Cudd* mgr);
+  static Int spillParkedDds(vector<SubtreeFrame>& frames); // returns number of spilled ADDs
+  static Int reloadSpilledDds(SubtreeFrame& frame, const Cudd* mgr); // returns number of reloaded ADDs
+  static std::atomic<Int> hardenedConstraintCount; // soft constraints compiled as 0/bound masks, as weight >= bound - LB
+  static Dd solveTerminal(
+    const JoinNode* joinNode,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    Int& LB,
+    map<int, Dd>& allADDs,
+    const Cudd* mgr,
+    const Assignment& assignment
+  );
+  static Dd solveNonterminal( // consumes childDdList
+    const JoinNode* joinNode,
+    vector<Dd>& childDdList,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    Int& LB,
+    stack<pair<int, Dd> >& stackMaximizer,
+    map<int, Dd>& allADDs,
+    const Cudd* mgr,
+    const Assignment& assignment,
+    TimePoint sliceStartPoint
+  );
   static Dd solveSubtree(
     const JoinNode* joinNode,
     const Map<Int, Int>& cnfVarToDdVarMap,
@@ -237,22 +495,100 @@ public:
     stack<pair<int, Dd> > &stackMaximizer,
     map<int, Dd>& allADDs,
     const Cudd* mgr = nullptr,
-    const Assignment& assignment = Assignment()
+    const Assignment& assignment = Assignment(),
+    TimePoint sliceStartPoint = TimePoint(), // default for unbudgeted slice
+    Map<Int, Dd>* nodeDds = nullptr // nodeIndex |-> ADD of solved join node, for maximizer
   );
-    static void solveThreadSlices( // sequentially solves all slices in 1 thread
+  static Assignment bestMaximizer; // over finished slices
+  static std::optional<Number> bestMaximizerCost; // empty until some slice is solved
+  static Assignment getMaximizer( // top-down over join tree: argmin of each node given ancestors' choices
+    const JoinNonterminal* joinRoot,
+    const Map<Int, Dd>& nodeDds,
+    const vector<Int>& ddVarToCnfVarMap,
+    const Cudd* mgr,
+    const Assignment& assignment // of slice
+  );
+  static void printMaximizerRow(const Assignment& maximizer); // "v {literals}"
+  static void checkSliceBudget(const Dd& dd, TimePoint sliceStartPoint); // throws SliceBudgetException
+  static std::atomic<Int> incumbentCost; // best cost of finished plain-MaxSAT slices, shared by all threads
+  static Int getStaticBound(); // costs at least this are capped, so they come from no model
+  static Int getPruningBound(); // for Dd::getThreshold
+  static void updateIncumbentCost(Int cost); // ignores capped costs
+  static void checkSliceBound(Int LB, const Assignment& assignment); // throws SliceBoundException
+  static mutex boundMutex; // guards anytime bounds and final output
+  static bool solvingFinished; // final output is printed by main thread, not watchdog
+  static Map<string, Int> pendingSliceLBs; // sliceKey |-> lower bound on cost of queued or running plain-MaxSAT slice
+  static bool slicingStarted; // pendingSliceLBs covers all assignments
+  static Int reportedLB; // of whole instance
+  static Int reportedUB;
+  static bool isAnytime(); // plain MaxSAT, where slices are combined by min
+  static void reportBounds(); // with boundMutex held: prints improved "o" and lower-bound lines
+  static void splitPendingSlice(const Assignment& assignment, Int splitVar); // children inherit lower bound
+  static void finishPendingSlice(const Assignment& assignment);
+  static void watchDeadline(); // in watchdog thread, with SIGTERM blocked in all threads
+  static void startWatchdog();
+  static void finishSolving(); // called before final output
+  static vector<LocalSearcher> localSearchers;
+  static vector<thread> localSearchThreads;
+  static std::atomic<bool> localSearchStopping;
+  static Assignment localSearchModel; // for maximizer, guarded by boundMutex
+  static Int localSearchCost; // also of previous runs, by checkpoint
+  static bool localSearchCheckpointing; // checkpointKey is set, guarded by boundMutex
+  static void writeLocalSearchRecord(); // with boundMutex held
+  static void updateLocalSearchModel(const vector<bool>& vals, Int cost); // in local-search thread: lowers incumbentCost
+  static void startLocalSearch(); // during planning, so that first slices are already pruned
+  static void stopLocalSearch();
+  static mutex reorderingMutex;
+  static Map<const Cudd*, Int> reorderingBaselines; // manager |-> node count of trigger join result right after last reordering
+  static Int reorderingCount;
+  static Float reorderingSeconds;
+  static Int reorderingSavedNodeCount; // live nodes before minus after, summed over reorderings
+  static void reorderOnGrowth(Int nodeIndex, const Dd& dd, const Cudd* mgr); // between joins
+  static void printReorderingStats();
+  static string checkpointKey; // hash of instance, join tree, and diagram var order
+  static mutex checkpointMutex;
+  static Map<string, vector<string>> checkpointRecords; // sliceKey |-> record type and fields from previous runs
+  static string getCheckpointString(const Number& n); // exact, readable by Number(string)
+  static string getCheckpointKey(const JoinNonterminal* joinRoot, const vector<Int>& ddVarToCnfVarMap);
+  static string getSliceKey(const Assignment& assignment);
+  static string getSubtreeCheckpointPath(const Assignment& assignment, Int nodeIndex);
+  static void readCheckpoint(); // also lowers incumbentCost
+  static void appendCheckpointRecord(const string& record);
+  static void writeSliceRecord(const string& recordType, const Assignment& assignment, const vector<string>& fields = {});
+  static void removeCheckpointFiles(const string& filePrefix);
+  static std::atomic<Int> idleSubtreeThreadCount;
+  static Float subtreeThreadMem; // in MB
+  static bool acquireSubtreeThread();
+  static vector<const Cudd*> idleSubtreeMgrs; // recycled managers of finished subtree tasks
+  static mutex subtreeMgrMutex;
+  static const Cudd* acquireSubtreeMgr(Int threadIndex);
+  static void releaseSubtreeMgr(const Cudd* mgr);
+  static void solveSubtreeTask( // in worker thread
+    SubtreeTask& task,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    const Assignment& assignment,
+    TimePoint sliceStartPoint
+  );
+  static void finishSubtreeTasks( // joins workers, then moves their ADDs into mgr
+    vector<SubtreeTask>& tasks,
+    vector<Dd>& childDdList,
+    Int& LB,
+    const Cudd* mgr,
+    bool transferring = true // false when unwinding
+  );
+  static void solveThreadSlices( // solves slices from queue in 1 thread
     const JoinNonterminal* joinRoot,
     const Map<Int, Int>& cnfVarToDdVarMap,
     const vector<Int>& ddVarToCnfVarMap,
     Float threadMem,
     Int threadIndex,
-    const vector<vector<Assignment>>& threadAssignmentLists,
+    SliceQueue& sliceQueue,
     Number& totalSolution,
     mutex& solutionMutex
   );
-  static vector<vector<Assignment>> getThreadAssignmentLists(
-    const JoinNonterminal* joinRoot,
-    Int sliceVarOrderHeuristic
-  );
+  static bool sliceSolved; // totalSolution holds a MaxSAT slice cost, as min and max have no mpq identity
+  static vector<Assignment> getInitialAssignments(const vector<Int>& sliceVarOrder);
   static Number solveCnf(
     const JoinNonterminal* joinRoot,
     const Map<Int, Int>& cnfVarToDdVarMap,
@@ -283,6 +619,7 @@ public:
 
   static string helpDdPackage();
   static string helpJoinPriority();
+  static string helpDdReordering();
 
   void runCommand() const;
 
@@ -38,8 +38,11 @@ string util::helpVarOrderHeuristic(string prefix) {
     s += useDdPackage(CUDD);
     heuristics = getVarOrderHeuristics();
   }
+  else if (prefix == "diagram") {
+    heuristics[LAST_ELIMINATED] = JOIN_TREE_VAR_ORDER_HEURISTICS.at(LAST_ELIMINATED);
+  }
   else {
-    assert(prefix == "diagram" || prefix == "cluster");
+    assert(prefix == "cluster");
   }
 
   s += ": ";
@@ -409,6 +412,17 @@ Set<Int> Cnf::getDisjunctiveVars() const {
   return disjunctiveVars;
 }
 
+Set<Int> Cnf::getSliceVars() const {
+  bool minVarSlicing = maxsatSolving && !minMaxsatSolving; // plain maxsat has no additive vars, so slices are combined by min
+  Set<Int> sliceVars;
+  for (Int var : apparentVars) {
+    if (additiveVars.contains(var) != minVarSlicing) {
+      sliceVars.insert(var);
+    }
+  }
+  return sliceVars;
+}
+
 
 
 void Cnf::addClause(const Clause& clause, char type, double weight, int comparator, Map<Int, Int> coefs, int k ){
@@ -735,6 +749,9 @@ Cnf::Cnf(string filePath) {
           }
         }
       }
+      else if (words.front() == "c" && words.size() == 3 && words.at(1) == COST_OFFSET_WORD) { // written by preprocessor pre
+        costOffset += stoll(words.at(2));
+      }
     }
     else if (Set<string>{"s", "INDETERMINATE"}.contains(words.front())) { // preprocessor pmc
       throw MyError("unexpected output from preprocessor pmc | line ", lineIndex, ": ", line);
@@ -970,6 +987,17 @@ vector<Assignment> Assignment::extendAssignments(const vector<Assignment>& assig
   return extendedAssignments;
 }
 
+vector<Assignment> Assignment::getPrefixAssignments(const vector<Int>& varOrder, Int varCount) {
+  vector<Assignment> assignments;
+  for (Int i = 0; i < varOrder.size() && i < varCount; i++) {
+    assignments = extendAssignments(assignments, varOrder.at(i));
+  }
+  if (assignments.empty()) {
+    assignments.push_back(Assignment());
+  }
+  return assignments;
+}
+
 /* class JoinNode =========================================================== */
 
 Int JoinNode::nodeCount;
@@ -1174,6 +1202,41 @@ vector<Int> JoinNonterminal::getHighestNodeVarOrder() const {
   return varOrder;
 }
 
+vector<Int> JoinNonterminal::getLastEliminatedVarOrder() const {
+  vector<Int> eliminationOrder; // vars projected deeper come first
+  vector<pair<const JoinNonterminal*, Int>> nodeStack = {{this, 0}}; // (node, index of next child to visit)
+  while (!nodeStack.empty()) {
+    auto& [node, childIndex] = nodeStack.back();
+    if (childIndex < node->children.size()) {
+      const JoinNode* child = node->children.at(childIndex++);
+      if (!child->isTerminal()) {
+        nodeStack.push_back({static_cast<const JoinNonterminal*>(child), 0});
+      }
+      continue;
+    }
+    vector<pair<Int, Int>> clausedVars; // (first clause index, var), so vars sharing clauses stay together
+    for (Int var : node->projectionVars) {
+      const Set<Int>& clauseIndices = cnf.varToClauses.at(var);
+      clausedVars.push_back({*std::min_element(clauseIndices.begin(), clauseIndices.end()), var});
+    }
+    sort(clausedVars.begin(), clausedVars.end());
+    for (auto [clauseIndex, var] : clausedVars) {
+      eliminationOrder.push_back(var);
+    }
+    nodeStack.pop_back();
+  }
+
+  Set<Int> eliminatedVars(eliminationOrder.begin(), eliminationOrder.end());
+  vector<Int> varOrder;
+  for (Int var : cnf.getDeclaredVarOrder()) {
+    if (!eliminatedVars.contains(var)) { // live up to root, so on top
+      varOrder.push_back(var);
+    }
+  }
+  varOrder.insert(varOrder.end(), eliminationOrder.rbegin(), eliminationOrder.rend()); // vars projected deeper go near bottom
+  return varOrder;
+}
+
 vector<Int> JoinNonterminal::getVarOrder(Int varOrderHeuristic) const {
   if (CNF_VAR_ORDER_HEURISTICS.contains(abs(varOrderHeuristic))) {
     return cnf.getCnfVarOrder(varOrderHeuristic);
@@ -1183,10 +1246,13 @@ vector<Int> JoinNonterminal::getVarOrder(Int varOrderHeuristic) const {
   if (abs(varOrderHeuristic) == BIGGEST_NODE) {
     varOrder = getBiggestNodeVarOrder();
   }
-  else {
-    assert(abs(varOrderHeuristic) == HIGHEST_NODE);
+  else if (abs(varOrderHeuristic) == HIGHEST_NODE) {
     varOrder = getHighestNodeVarOrder();
   }
+  else {
+    assert(abs(varOrderHeuristic) == LAST_ELIMINATED);
+    varOrder = getLastEliminatedVarOrder();
+  }
 
   if (varOrderHeuristic < 0) {
     reverse(varOrder.begin(), varOrder.end());
@@ -1195,44 +1261,31 @@ vector<Int> JoinNonterminal::getVarOrder(Int varOrderHeuristic) const {
   return varOrder;
 }
 
-vector<Assignment> JoinNonterminal::getAdditiveAssignments(Int varOrderHeuristic, Int sliceVarCount) const {
-  if (sliceVarCount <= 0) {
-    return vector<Assignment>{Assignment()};
-  }
-
+vector<Int> JoinNonterminal::getSliceVarOrder(Int varOrderHeuristic) const {
   TimePoint sliceVarOrderStartPoint = util::getTimePoint();
   vector<Int> varOrder = getVarOrder(varOrderHeuristic);
+  Set<Int> sliceVars = cnf.getSliceVars();
+
+  vector<Int> sliceVarOrder;
+  for (Int var : varOrder) {
+    if (sliceVars.contains(var)) {
+      sliceVarOrder.push_back(var);
+    }
+  }
+
   if (verboseSolving >= 1) {
     util::printRow("sliceVarSeconds", util::getDuration(sliceVarOrderStartPoint));
   }
 
-  TimePoint assignmentsStartPoint = util::getTimePoint();
-  vector<Assignment> assignments;
-
   if (verboseSolving >= 2) {
     cout << "c slice var order: {";
-  }
-
-  for (Int i = 0, assignedVars = 0; i < varOrder.size() && assignedVars < sliceVarCount; i++) {
-    Int var = varOrder.at(i);
-    if (cnf.additiveVars.contains(var)) {
-      assignments = Assignment::extendAssignments(assignments, var);
-      assignedVars++;
-      if (verboseSolving >= 2) {
-        cout << " " << var;
-      }
+    for (Int var : sliceVarOrder) {
+      cout << " " << var;
     }
-  }
-
-  if (verboseSolving >= 2) {
     cout << " }\n";
   }
 
-  if (verboseSolving >= 1) {
-    util::printRow("sliceAssignmentsSeconds", util::getDuration(assignmentsStartPoint));
-  }
-
-  return assignments;
+  return sliceVarOrder;
 }
 
 JoinNonterminal::JoinNonterminal(const vector<JoinNode*>& children, const Set<Int>& projectionVars, Int requestedNodeIndex) {
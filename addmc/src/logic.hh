@@ -58,6 +58,7 @@ const Int MAX_INT = std::numeric_limits<Int>::max();
 const Float INF = std::numeric_limits<Float>::infinity();
 
 const string JT_WORD = "jt";
+const string COST_OFFSET_WORD = "offset"; // in comment line "c offset {cost}"
 const string VAR_ELIM_WORD = "e";
 
 const string WARNING = "c MY_WARNING: ";
@@ -96,9 +97,11 @@ const map<Int, string> CNF_VAR_ORDER_HEURISTICS = {
 
 const Int BIGGEST_NODE = 7;
 const Int HIGHEST_NODE = 8;
+const Int LAST_ELIMINATED = 9; // also a diagram var order
 const map<Int, string> JOIN_TREE_VAR_ORDER_HEURISTICS = {
   {BIGGEST_NODE, "BIGGEST_NODE"},
-  {HIGHEST_NODE, "HIGHEST_NODE"}
+  {HIGHEST_NODE, "HIGHEST_NODE"},
+  {LAST_ELIMINATED, "LAST_ELIMINATED"}
 };
 
 const string BUCKET_LIST = "bel";
@@ -299,6 +302,7 @@ public:
   vector<char> types;  // type of constraints; 'x' for XOR, 'c' for CNF clause, 'p' for pseudo-Boolean constraints
   Int declaredVarCount = 0;
   Int trivialBoundPartialMaxSAT = LLONG_MAX; // the trivial bound given by a partial MaxSAT problem for ADD pruning
+  Int costOffset = 0; // of soft constraints already falsified by preprocessing
   Set<Int> apparentVars; // as opposed to hidden vars that are declared but appear in no clause
   Set<Int> additiveVars; // as opposed to existential vars
   Map<Int, Number> literalWeights; // for additive and disjunctive vars
@@ -309,6 +313,7 @@ public:
   void printClauses() const;
   void printLiteralWeights() const;
   Set<Int> getDisjunctiveVars() const;
+  Set<Int> getSliceVars() const; // apparent vars that threads may condition on
 
   void addClause(const Clause& clause, char type, double weight, int comparator = 0, Map<Int, Int> coefs = Map<Int, Int>(), int k = 0);
   void setApparentVars();
@@ -335,6 +340,7 @@ public:
 
   void printAssignment() const;
   static vector<Assignment> extendAssignments(const vector<Assignment>& assignments, Int var);
+  static vector<Assignment> getPrefixAssignments(const vector<Int>& varOrder, Int varCount); // all assignments to first varCount vars
 };
 
 class JoinNode { // abstract
@@ -395,9 +401,10 @@ public:
   void updateVarSizes(Map<Int, size_t>& varSizes) const override;
   vector<Int> getBiggestNodeVarOrder() const;
   vector<Int> getHighestNodeVarOrder() const;
+  vector<Int> getLastEliminatedVarOrder() const; // reverse post-order elimination, so vars of a subtree stay together
   vector<Int> getVarOrder(Int varOrderHeuristic) const;
 
-  vector<Assignment> getAdditiveAssignments(Int varOrderHeuristic, Int sliceVarCount) const;
+  vector<Int> getSliceVarOrder(Int varOrderHeuristic) const; // slice vars in var order
 
   JoinNonterminal(
     const vector<JoinNode*>& children,
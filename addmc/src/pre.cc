@@ -0,0 +1,801 @@
+#include "pre.hh"
+
+/* classes ================================================================== */
+
+/* class XorSystem ========================================================== */
+
+bool XorSystem::getBit(Int row, Int column) const {
+  return (rows.at(row).at(column / WORD_BITS) >> (column % WORD_BITS)) & 1;
+}
+
+void XorSystem::addRow(Int targetRow, Int sourceRow) {
+  uint64_t* target = rows.at(targetRow).data();
+  const uint64_t* source = rows.at(sourceRow).data();
+  for (Int word = 0; word < wordCount; word++) { // vectorizable
+    target[word] ^= source[word];
+  }
+  parities.at(targetRow) = parities.at(targetRow) != parities.at(sourceRow);
+}
+
+Int XorSystem::choosePivotColumn(Int row, const Set<Int>& sharedVars) const {
+  Int pivotColumn = MIN_INT;
+  for (Int word = 0; word < wordCount; word++) {
+    for (uint64_t bits = rows.at(row).at(word); bits != 0; bits &= bits - 1) {
+      Int column = word * WORD_BITS + std::countr_zero(bits);
+      if (!sharedVars.contains(columnVars.at(column))) {
+        return column;
+      }
+      if (pivotColumn == MIN_INT) {
+        pivotColumn = column;
+      }
+    }
+  }
+  return pivotColumn;
+}
+
+void XorSystem::eliminate(const Set<Int>& sharedVars) {
+  pivotColumns.assign(rows.size(), MIN_INT);
+  for (Int row = 0; row < rows.size(); row++) {
+    Int pivotColumn = choosePivotColumn(row, sharedVars);
+    if (pivotColumn == MIN_INT) { // row reduced to 0 = parity
+      if (parities.at(row)) {
+        consistent = false;
+        return;
+      }
+      continue;
+    }
+    pivotColumns.at(row) = pivotColumn;
+    for (Int otherRow = 0; otherRow < rows.size(); otherRow++) { // also rows above, so pivot vars are substituted out everywhere
+      if (otherRow != row && getBit(otherRow, pivotColumn)) {
+        addRow(otherRow, row);
+      }
+    }
+  }
+}
+
+Int XorSystem::getRank() const {
+  return rows.size() - std::count(pivotColumns.begin(), pivotColumns.end(), MIN_INT);
+}
+
+Clause XorSystem::getXorClause(Int row) const {
+  assert(pivotColumns.at(row) != MIN_INT);
+  Clause clause;
+  bool negating = !parities.at(row); // -x = x XOR 1
+  for (Int word = 0; word < wordCount; word++) {
+    for (uint64_t bits = rows.at(row).at(word); bits != 0; bits &= bits - 1) {
+      Int var = columnVars.at(word * WORD_BITS + std::countr_zero(bits));
+      clause.insert(negating ? -var : var);
+      negating = false;
+    }
+  }
+  return clause;
+}
+
+XorSystem::XorSystem(const vector<Clause>& xorClauses) {
+  for (const Clause& clause : xorClauses) {
+    for (Int literal : clause) {
+      Int var = abs(literal);
+      if (!varColumns.contains(var)) {
+        varColumns[var] = columnVars.size();
+        columnVars.push_back(var);
+      }
+    }
+  }
+  wordCount = (columnVars.size() + WORD_BITS - 1) / WORD_BITS;
+
+  for (const Clause& clause : xorClauses) {
+    vector<uint64_t> row(wordCount, 0);
+    bool parity = true; // clause is satisfied by odd parity of its literals
+    for (Int literal : clause) {
+      Int column = varColumns.at(abs(literal));
+      row.at(column / WORD_BITS) ^= uint64_t(1) << (column % WORD_BITS);
+      if (literal < 0) {
+        parity = !parity;
+      }
+    }
+    rows.push_back(row);
+    parities.push_back(parity);
+  }
+}
+
+/* class Preprocessor ======================================================= */
+
+bool Preprocessor::isHard(Int clauseIndex) const {
+  if (maxsatSolving) {
+    return cnf.trivialBoundPartialMaxSAT != LLONG_MAX && cnf.weights.at(clauseIndex) >= cnf.trivialBoundPartialMaxSAT;
+  }
+  return cnf.weights.at(clauseIndex) == 1; // other weights scale model counts
+}
+
+void Preprocessor::addClause(const Clause& clause, char type, double weight) {
+  Int clauseIndex = cnf.clauses.size();
+  cnf.addClause(clause, type, weight);
+  removedClauses.push_back(false);
+  for (Int var : clause.getClauseVars()) {
+    varClauses[var].insert(clauseIndex);
+  }
+}
+
+void Preprocessor::removeClause(Int clauseIndex) {
+  removedClauses.at(clauseIndex) = true;
+  for (Int var : cnf.clauses.at(clauseIndex).getClauseVars()) {
+    varClauses.at(var).erase(clauseIndex);
+  }
+}
+
+void Preprocessor::removeLiteral(Int clauseIndex, Int literal) {
+  Clause& clause = cnf.clauses.at(clauseIndex);
+  clause.erase(literal);
+  cnf.coefLists.at(clauseIndex).erase(literal);
+  if (!clause.contains(-literal)) {
+    varClauses.at(abs(literal)).erase(clauseIndex);
+  }
+}
+
+void Preprocessor::falsifyClause(Int clauseIndex) {
+  if (isHard(clauseIndex)) {
+    consistent = false;
+  }
+  else {
+    costOffset += cnf.weights.at(clauseIndex);
+  }
+  removeClause(clauseIndex);
+}
+
+void Preprocessor::simplifyClause(Int clauseIndex, vector<Int>& unitQueue) {
+  Clause& clause = cnf.clauses.at(clauseIndex);
+  char type = cnf.types.at(clauseIndex);
+  vector<Int> assignedLiterals;
+  for (Int literal : clause) {
+    if (fixedVals.contains(abs(literal))) {
+      assignedLiterals.push_back(literal);
+    }
+  }
+
+  if (type == 'c') {
+    for (Int literal : assignedLiterals) {
+      if (fixedVals.at(abs(literal)) == (literal > 0)) {
+        removeClause(clauseIndex);
+        return;
+      }
+    }
+    for (Int literal : assignedLiterals) {
+      removeLiteral(clauseIndex, literal);
+    }
+    if (clause.empty()) {
+      falsifyClause(clauseIndex);
+    }
+    else if (clause.size() == 1 && isHard(clauseIndex)) {
+      unitQueue.push_back(*clause.begin());
+    }
+  }
+  else if (type == 'x') {
+    bool parity = true; // XOR of remaining literals
+    for (Int literal : assignedLiterals) {
+      if (fixedVals.at(abs(literal)) == (literal > 0)) {
+        parity = !parity;
+      }
+      removeLiteral(clauseIndex, literal);
+    }
+    if (clause.empty()) {
+      if (parity) {
+        falsifyClause(clauseIndex);
+      }
+      else {
+        removeClause(clauseIndex);
+      }
+      return;
+    }
+    if (!parity) { // -x = x XOR 1
+      Int literal = *clause.begin();
+      clause.erase(literal);
+      clause.insert(-literal);
+    }
+    if (clause.size() == 1 && isHard(clauseIndex)) {
+      unitQueue.push_back(*clause.begin());
+    }
+  }
+  else {
+    assert(type == 'p');
+    int& k = cnf.klist.at(clauseIndex);
+    for (Int literal : assignedLiterals) {
+      if (fixedVals.at(abs(literal)) == (literal > 0)) {
+        k -= cnf.coefLists.at(clauseIndex).at(literal);
+      }
+      removeLiteral(clauseIndex, literal);
+    }
+    Int coefSum = 0;
+    for (auto [literal, coef] : cnf.coefLists.at(clauseIndex)) {
+      coefSum += coef;
+    }
+    if (k > coefSum || (cnf.comparators.at(clauseIndex) == 2 && k < 0)) {
+      falsifyClause(clauseIndex);
+    }
+    else if (clause.empty() || (cnf.comparators.at(clauseIndex) == 1 && k <= 0)) {
+      removeClause(clauseIndex);
+    }
+  }
+}
+
+void Preprocessor::propagateUnits(vector<Int> unitQueue) {
+  for (Int clauseIndex = 0; clauseIndex < cnf.clauses.size(); clauseIndex++) {
+    if (!removedClauses.at(clauseIndex) && cnf.types.at(clauseIndex) != 'p' && cnf.clauses.at(clauseIndex).size() == 1 && isHard(clauseIndex)) { // a unit XOR is a unit clause
+      unitQueue.push_back(*cnf.clauses.at(clauseIndex).begin());
+    }
+  }
+  while (!unitQueue.empty() && consistent) {
+    Int literal = unitQueue.back();
+    unitQueue.pop_back();
+    Int var = abs(literal);
+    if (minMaxsatSolving && cnf.additiveVars.contains(var)) { // max over var would pick the assignment falsifying the unit
+      continue;
+    }
+    auto it = fixedVals.find(var);
+    if (it != fixedVals.end()) {
+      consistent = it->second == (literal > 0);
+      continue;
+    }
+    fixedVals[var] = literal > 0;
+    fixedVarCount++;
+    reconstructionSteps.push_back({'r', {literal}});
+    Set<Int> clauseIndices = varClauses[var]; // copied, as simplification removes occurrences
+    for (Int clauseIndex : clauseIndices) {
+      if (!removedClauses.at(clauseIndex)) {
+        simplifyClause(clauseIndex, unitQueue);
+      }
+    }
+  }
+}
+
+void Preprocessor::mergeDuplicates() {
+  Map<string, Int> keyClauses; // type and sorted literals |-> clause index
+  for (Int clauseIndex = 0; clauseIndex < cnf.clauses.size(); clauseIndex++) {
+    char type = cnf.types.at(clauseIndex);
+    if (removedClauses.at(clauseIndex) || type == 'p') {
+      continue;
+    }
+    string key(1, type);
+    for (Int literal : std::set<Int>(cnf.clauses.at(clauseIndex).begin(), cnf.clauses.at(clauseIndex).end())) {
+      key += " " + to_string(literal);
+    }
+    auto [it, inserted] = keyClauses.insert({key, clauseIndex});
+    if (inserted) {
+      continue;
+    }
+    Int keptIndex = it->second;
+    if (isHard(keptIndex) || isHard(clauseIndex)) { // a soft copy of a hard constraint is always satisfied
+      if (!isHard(keptIndex)) {
+        it->second = clauseIndex;
+        removeClause(keptIndex);
+      }
+      else {
+        removeClause(clauseIndex);
+      }
+    }
+    else {
+      cnf.weights.at(keptIndex) += cnf.weights.at(clauseIndex);
+      removeClause(clauseIndex);
+    }
+    mergedClauseCount++;
+  }
+}
+
+Int Preprocessor::getSubsumption(const Clause& subsumer, const Clause& clause) {
+  Int flippedLiteral = 0;
+  for (Int literal : subsumer) {
+    if (clause.contains(literal)) {
+      continue;
+    }
+    if (flippedLiteral == 0 && clause.contains(-literal)) {
+      flippedLiteral = literal;
+    }
+    else {
+      return MIN_INT;
+    }
+  }
+  return flippedLiteral;
+}
+
+void Preprocessor::subsumeClauses(vector<Int>& unitQueue) {
+  vector<Int> clauseIndices;
+  for (Int clauseIndex = 0; clauseIndex < cnf.clauses.size(); clauseIndex++) {
+    if (!removedClauses.at(clauseIndex) && cnf.types.at(clauseIndex) == 'c' && isHard(clauseIndex)) {
+      clauseIndices.push_back(clauseIndex);
+    }
+  }
+  sort(clauseIndices.begin(), clauseIndices.end(), [&](Int i, Int j) {
+    return cnf.clauses.at(i).size() < cnf.clauses.at(j).size();
+  }); // short subsumers first
+
+  for (Int clauseIndex : clauseIndices) {
+    if (!consistent) {
+      return;
+    }
+    if (removedClauses.at(clauseIndex)) {
+      continue;
+    }
+    Clause subsumer = cnf.clauses.at(clauseIndex); // copied, as subsumer may be strengthened by an earlier one
+    Int rarestVar = MIN_INT;
+    for (Int var : subsumer.getClauseVars()) {
+      if (rarestVar == MIN_INT || varClauses.at(var).size() < varClauses.at(rarestVar).size()) {
+        rarestVar = var;
+      }
+    }
+    Set<Int> candidateIndices = varClauses.at(rarestVar);
+    for (Int candidateIndex : candidateIndices) {
+      const Clause& clause = cnf.clauses.at(candidateIndex);
+      if (candidateIndex == clauseIndex || removedClauses.at(candidateIndex) || cnf.types.at(candidateIndex) != 'c' || clause.size() < subsumer.size()) {
+        continue;
+      }
+      Int subsumption = getSubsumption(subsumer, clause);
+      if (subsumption == 0) { // also a soft clause, which is then never violated
+        removeClause(candidateIndex);
+        subsumedClauseCount++;
+      }
+      else if (subsumption != MIN_INT) { // resolvent with subsumer subsumes clause; sound for soft clause too, as hard subsumer holds
+        removeLiteral(candidateIndex, -subsumption);
+        strengthenedClauseCount++;
+        if (clause.empty()) {
+          falsifyClause(candidateIndex);
+        }
+        else if (clause.size() == 1 && isHard(candidateIndex)) {
+          unitQueue.push_back(*clause.begin());
+        }
+      }
+    }
+  }
+}
+
+bool Preprocessor::isHardOnlyVar(Int var) const {
+  if (fixedVals.contains(var) || (minMaxsatSolving && cnf.additiveVars.contains(var))) {
+    return false;
+  }
+  for (Int clauseIndex : varClauses.at(var)) {
+    if (cnf.types.at(clauseIndex) != 'c' || !isHard(clauseIndex)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Preprocessor::eliminateVars() {
+  vector<Int> vars;
+  for (const auto& [var, clauseIndices] : varClauses) {
+    if (!clauseIndices.empty()) {
+      vars.push_back(var);
+    }
+  }
+  sort(vars.begin(), vars.end(), [&](Int var1, Int var2) {
+    return varClauses.at(var1).size() < varClauses.at(var2).size();
+  }); // cheap vars first
+
+  for (Int var : vars) {
+    if (!consistent) {
+      return;
+    }
+    if (varClauses.at(var).empty() || !isHardOnlyVar(var)) {
+      continue;
+    }
+    vector<Int> posIndices;
+    vector<Int> negIndices;
+    for (Int clauseIndex : varClauses.at(var)) {
+      (cnf.clauses.at(clauseIndex).contains(var) ? posIndices : negIndices).push_back(clauseIndex);
+    }
+    if (posIndices.size() * negIndices.size() > ELIM_MAX_RESOLVENT_PAIRS) {
+      continue;
+    }
+
+    vector<Clause> resolvents;
+    bool eliminating = true;
+    for (Int posIndex : posIndices) {
+      for (Int negIndex : negIndices) {
+        Clause resolvent = cnf.clauses.at(posIndex);
+        resolvent.erase(var);
+        bool tautological = false;
+        for (Int literal : cnf.clauses.at(negIndex)) {
+          if (literal == -var) {
+            continue;
+          }
+          if (resolvent.contains(-literal)) {
+            tautological = true;
+            break;
+          }
+          resolvent.insert(literal);
+        }
+        if (tautological) {
+          continue;
+        }
+        if (resolvent.size() > ELIM_MAX_RESOLVENT_SIZE) {
+          eliminating = false;
+          break;
+        }
+        resolvents.push_back(resolvent);
+      }
+      if (!eliminating || resolvents.size() > posIndices.size() + negIndices.size()) {
+        eliminating = false;
+        break;
+      }
+    }
+    if (!eliminating) {
+      continue;
+    }
+
+    double weight = 0; // of resolvents
+    for (Int posIndex : posIndices) {
+      vector<Int> step{var}; // var is set true iff clause is falsified by other vars
+      for (Int literal : cnf.clauses.at(posIndex)) {
+        if (literal != var) {
+          step.push_back(literal);
+        }
+      }
+      reconstructionSteps.push_back({'r', step});
+    }
+    reconstructionSteps.push_back({'r', {-var}}); // default, applied before steps above
+    for (const vector<Int>& clauseIndices : {posIndices, negIndices}) {
+      for (Int clauseIndex : clauseIndices) {
+        weight = max(weight, cnf.weights.at(clauseIndex));
+        removeClause(clauseIndex);
+      }
+    }
+    for (const Clause& resolvent : resolvents) {
+      if (resolvent.empty()) {
+        consistent = false;
+        return;
+      }
+      addClause(resolvent, 'c', weight);
+    }
+    eliminatedVarCount++;
+  }
+}
+
+void Preprocessor::reduceXors() {
+  vector<Clause> xorClauses;
+  double hardWeight = 0; // of reduced XOR constraints
+  for (Int clauseIndex = 0; clauseIndex < cnf.clauses.size(); clauseIndex++) {
+    if (!removedClauses.at(clauseIndex) && cnf.types.at(clauseIndex) == 'x' && isHard(clauseIndex)) {
+      xorClauses.push_back(cnf.clauses.at(clauseIndex));
+      hardWeight = max(hardWeight, cnf.weights.at(clauseIndex));
+      removeClause(clauseIndex);
+    }
+  }
+  hardXorCount = xorClauses.size();
+  if (xorClauses.empty()) {
+    return;
+  }
+
+  Set<Int> sharedVars; // occurring outside hard XOR constraints
+  for (const auto& [var, clauseIndices] : varClauses) {
+    if (!clauseIndices.empty()) {
+      sharedVars.insert(var);
+    }
+  }
+  if (minMaxsatSolving) {
+    util::unionize(sharedVars, cnf.additiveVars);
+  }
+
+  XorSystem xorSystem(xorClauses);
+  xorSystem.eliminate(sharedVars);
+  consistent = xorSystem.consistent;
+  if (!consistent) {
+    return;
+  }
+  xorRank = xorSystem.getRank();
+
+  for (Int row = 0; row < xorSystem.rows.size(); row++) {
+    Int pivotColumn = xorSystem.pivotColumns.at(row);
+    if (pivotColumn == MIN_INT) { // redundant
+      continue;
+    }
+    Clause clause = xorSystem.getXorClause(row);
+    Int pivotVar = xorSystem.columnVars.at(pivotColumn);
+    if (maxsatSolving && !sharedVars.contains(pivotVar)) { // pivot var can always satisfy row, without changing any cost
+      vector<Int> step{pivotVar};
+      step.insert(step.end(), clause.begin(), clause.end());
+      reconstructionSteps.push_back({'x', step});
+      droppedXorCount++;
+      continue;
+    } // a hidden var would double model counts, so rows are kept for counting
+    addClause(clause, 'x', hardWeight);
+  }
+}
+
+string Preprocessor::getWeightWord(double weight) {
+  if (weight == std::floor(weight)) {
+    return to_string((Int) weight);
+  }
+  std::ostringstream stream;
+  stream << setprecision(17) << weight;
+  return stream.str();
+}
+
+void Preprocessor::writeConstraint(ostream& os, const Clause& clause, char type, double weight, Int comparator, const Map<Int, Int>& coefs, Int k) const {
+  os << "[" << getWeightWord(weight) << "]";
+  if (type == 'p') { // hwcnf takes positive vars with signed coefs
+    for (auto [literal, coef] : coefs) {
+      if (literal < 0) { // c * -x = c - c * x
+        os << " -" << coef << " x" << -literal;
+        k -= coef;
+      }
+      else {
+        os << " +" << coef << " x" << literal;
+      }
+    }
+    os << (comparator == 2 ? " = " : " >= ") << k << " ;\n";
+    return;
+  }
+  if (type == 'x') {
+    os << " x";
+  }
+  for (Int literal : clause) {
+    os << " " << literal;
+  }
+  os << " 0\n";
+}
+
+void Preprocessor::writeFormula(string filePath) const {
+  std::ofstream outputFileStream(filePath);
+  if (!outputFileStream.is_open()) {
+    throw MyError("unable to open file '", filePath, "'");
+  }
+
+  string boundWord = cnf.trivialBoundPartialMaxSAT != LLONG_MAX ? " " + to_string(cnf.trivialBoundPartialMaxSAT) : "";
+  if (!consistent) { // x1 and -x1
+    double hardWeight = maxsatSolving && cnf.trivialBoundPartialMaxSAT != LLONG_MAX ? cnf.trivialBoundPartialMaxSAT : 1;
+    outputFileStream << "p hwcnf " << max(cnf.declaredVarCount, 1ll) << " 2" << boundWord << "\n";
+    writeConstraint(outputFileStream, Clause{{1}}, 'x', hardWeight, 0, {}, 0);
+    writeConstraint(outputFileStream, Clause{{-1}}, 'x', hardWeight, 0, {}, 0);
+    return;
+  }
+
+  outputFileStream << "p hwcnf " << cnf.declaredVarCount << " " << std::count(removedClauses.begin(), removedClauses.end(), false) << boundWord << "\n";
+  if (costOffset != 0) {
+    outputFileStream << "c " << COST_OFFSET_WORD << " " << costOffset << "\n"; // read by dmc, skipped by lg
+  }
+  if (minMaxsatSolving) {
+    outputFileStream << "vm";
+    for (Int var : std::set<Int>(cnf.additiveVars.begin(), cnf.additiveVars.end())) {
+      outputFileStream << " " << var;
+    }
+    outputFileStream << "\n";
+  }
+  if (projectedCounting) {
+    outputFileStream << "vp";
+    for (Int var : std::set<Int>(cnf.additiveVars.begin(), cnf.additiveVars.end())) {
+      outputFileStream << " " << var;
+    }
+    outputFileStream << " 0\n";
+  }
+  if (weightedCounting) {
+    for (Int var = 1; var <= cnf.declaredVarCount; var++) {
+      if (cnf.literalWeights.at(var) != Number("1") || cnf.literalWeights.at(-var) != Number("1")) { // both literals, as a missing one would be completed to 1 minus the other
+        outputFileStream << "w " << var << " " << cnf.literalWeights.at(var) << " 0\n";
+        outputFileStream << "w " << -var << " " << cnf.literalWeights.at(-var) << " 0\n";
+      }
+    }
+  }
+  for (Int clauseIndex = 0; clauseIndex < cnf.clauses.size(); clauseIndex++) {
+    if (!removedClauses.at(clauseIndex)) {
+      writeConstraint(outputFileStream, cnf.clauses.at(clauseIndex), cnf.types.at(clauseIndex), cnf.weights.at(clauseIndex), cnf.comparators.at(clauseIndex), cnf.coefLists.at(clauseIndex), cnf.klist.at(clauseIndex));
+    }
+  }
+}
+
+void Preprocessor::writeReconstruction(string filePath) const {
+  std::ofstream outputFileStream(filePath);
+  if (!outputFileStream.is_open()) {
+    throw MyError("unable to open file '", filePath, "'");
+  }
+  outputFileStream << "p " << cnf.declaredVarCount << "\n";
+  for (const auto& [stepType, literals] : reconstructionSteps) {
+    outputFileStream << stepType;
+    for (Int literal : literals) {
+      outputFileStream << " " << literal;
+    }
+    outputFileStream << " 0\n";
+  }
+}
+
+void Preprocessor::printStats() const {
+  if (maxsatSolving) {
+    util::printRow("fixedVarCount", fixedVarCount);
+    util::printRow("mergedClauseCount", mergedClauseCount);
+    util::printRow("subsumedClauseCount", subsumedClauseCount);
+    util::printRow("strengthenedClauseCount", strengthenedClauseCount);
+    util::printRow("eliminatedVarCount", eliminatedVarCount);
+    util::printRow("costOffset", costOffset);
+  }
+  util::printRow("hardXorCount", hardXorCount);
+  if (!consistent) {
+    cout << "s UNSATISFIABLE\n";
+    return;
+  }
+  util::printRow("xorRank", xorRank);
+  util::printRow("droppedXorCount", droppedXorCount);
+  util::printRow("reducedClauseCount", std::count(removedClauses.begin(), removedClauses.end(), false));
+}
+
+void Preprocessor::printReconstructedModel(string reconstructionFilePath, string modelFilePath) {
+  Assignment model;
+  std::ifstream modelFileStream(modelFilePath);
+  if (!modelFileStream.is_open()) {
+    throw MyError("unable to open file '", modelFilePath, "'");
+  }
+  string line;
+  while (getline(modelFileStream, line)) {
+    vector<string> words = util::splitInputLine(line);
+    if (!words.empty() && words.front() == "v") {
+      for (Int i = 1; i < words.size(); i++) {
+        Int literal = stoll(words.at(i));
+        if (literal != 0) {
+          model[abs(literal)] = literal > 0;
+        }
+      }
+    }
+  }
+
+  std::ifstream reconstructionFileStream(reconstructionFilePath);
+  if (!reconstructionFileStream.is_open()) {
+    throw MyError("unable to open file '", reconstructionFilePath, "'");
+  }
+  Int declaredVarCount = 0;
+  vector<pair<char, vector<Int>>> steps;
+  while (getline(reconstructionFileStream, line)) {
+    vector<string> words = util::splitInputLine(line);
+    if (words.empty()) {
+      continue;
+    }
+    if (words.front() == "p") {
+      declaredVarCount = stoll(words.at(1));
+      continue;
+    }
+    vector<Int> literals;
+    for (Int i = 1; i < words.size() - 1; i++) { // skips "0"
+      literals.push_back(stoll(words.at(i)));
+    }
+    steps.push_back({words.front().front(), literals});
+  }
+
+  auto isTrue = [&](Int literal) {
+    auto it = model.find(abs(literal));
+    return (it != model.end() && it->second) == (literal > 0); // vars in no clause are false
+  };
+  for (auto it = steps.rbegin(); it != steps.rend(); it++) { // undoes eliminations last to first
+    const vector<Int>& literals = it->second;
+    if (it->first == 'r') {
+      if (std::none_of(next(literals.begin()), literals.end(), isTrue)) {
+        model[abs(literals.front())] = literals.front() > 0;
+      }
+    }
+    else {
+      assert(it->first == 'x');
+      Int pivotVar = literals.front();
+      model[pivotVar] = false;
+      if (std::count_if(next(literals.begin()), literals.end(), isTrue) % 2 == 0) { // XOR must be true
+        model[pivotVar] = true;
+      }
+    }
+  }
+
+  cout << "v";
+  for (Int var = 1; var <= declaredVarCount; var++) {
+    cout << " " << (isTrue(var) ? var : -var);
+  }
+  cout << "\n";
+}
+
+Preprocessor::Preprocessor(string cnfFilePath) {
+  cnf = Cnf(cnfFilePath);
+  costOffset = cnf.costOffset;
+  removedClauses.assign(cnf.clauses.size(), false);
+  for (const auto& [var, clauseIndices] : cnf.varToClauses) {
+    varClauses[var] = clauseIndices;
+  }
+
+  if (maxsatSolving) { // fixed and eliminated vars would be hidden vars, which change model counts
+    propagateUnits();
+    if (consistent) {
+      mergeDuplicates();
+      vector<Int> unitQueue; // of strengthened hard clauses
+      subsumeClauses(unitQueue);
+      if (consistent) {
+        propagateUnits(unitQueue);
+      }
+    }
+    if (consistent) {
+      eliminateVars();
+    }
+    if (consistent) {
+      propagateUnits(); // of resolvents
+    }
+  }
+  if (consistent) {
+    reduceXors();
+  }
+}
+
+/* class OptionDict ========================================================= */
+
+void OptionDict::runCommand() const {
+  if (verboseSolving >= 1) {
+    cout << "c processing command-line options...\n";
+    if (modelFilePath.empty()) {
+      util::printRow("cnfFile", cnfFilePath);
+      util::printRow("outputFile", outputFilePath);
+      util::printRow("weightedCounting", weightedCounting);
+      util::printRow("projectedCounting", projectedCounting);
+      util::printRow("maxsatSolving", maxsatSolving);
+    }
+    else {
+      util::printRow("modelFile", modelFilePath);
+    }
+    util::printRow("reconstructionFile", reconstructionFilePath);
+    cout << "\n";
+  }
+
+  if (!modelFilePath.empty()) {
+    Preprocessor::printReconstructedModel(reconstructionFilePath, modelFilePath);
+    return;
+  }
+  try {
+    Preprocessor preprocessor(cnfFilePath);
+    preprocessor.writeFormula(outputFilePath);
+    if (!reconstructionFilePath.empty()) {
+      preprocessor.writeReconstruction(reconstructionFilePath);
+    }
+    preprocessor.printStats();
+  }
+  catch (EmptyClauseException) {}
+}
+
+OptionDict::OptionDict(int argc, char** argv) {
+  cxxopts::Options options("pre", "Preprocessor (writes reduced hwcnf formula for lg and dmc)");
+  options.set_width(105);
+  options.add_options()
+    (CNF_FILE_OPTION, "cnf file path [without mf_arg]; string", value<string>())
+    (OUTPUT_FILE_OPTION, "output hwcnf file path [without mf_arg]; string", value<string>())
+    (RECONSTRUCTION_FILE_OPTION, "reconstruction file path for models, written with cf_arg and read with mf_arg; string", value<string>()->default_value(""))
+    (MODEL_FILE_OPTION, "model file path (with \"v\" line of reduced formula) for printing model of original formula; string", value<string>()->default_value(""))
+    (WEIGHTED_COUNTING_OPTION, "weighted counting (keeps literal weights): 0, 1; int", value<Int>()->default_value("0"))
+    (PROJECTED_COUNTING_OPTION, "projected counting (keeps projection vars): 0, 1; int", value<Int>()->default_value("0"))
+    (MAXSAT_OPTION, "MaxSAT solving (enables unit propagation, merging, subsumption and var elimination): 0, 1; int", value<Int>()->default_value("0"))
+    (VERBOSE_CNF_OPTION, "verbose cnf: 0, " + INPUT_VERBOSITIES, value<Int>()->default_value("0"))
+    (VERBOSE_SOLVING_OPTION, util::helpVerboseSolving(), value<Int>()->default_value("1"))
+  ;
+  cxxopts::ParseResult result = options.parse(argc, argv);
+  reconstructionFilePath = result[RECONSTRUCTION_FILE_OPTION].as<string>();
+  modelFilePath = result[MODEL_FILE_OPTION].as<string>();
+  if ((result.count(CNF_FILE_OPTION) && result.count(OUTPUT_FILE_OPTION)) || (!modelFilePath.empty() && !reconstructionFilePath.empty())) {
+    cout << "c pre process:\n";
+    cout << "c pid " << getpid() << "\n\n";
+
+    if (modelFilePath.empty()) {
+      cnfFilePath = result[CNF_FILE_OPTION].as<string>();
+      outputFilePath = result[OUTPUT_FILE_OPTION].as<string>();
+    }
+
+    weightedCounting = result[WEIGHTED_COUNTING_OPTION].as<Int>(); // global var
+    projectedCounting = result[PROJECTED_COUNTING_OPTION].as<Int>(); // global var
+    multiplePrecision = weightedCounting; // global var: literal weights are written as exact fractions
+    maxsatSolving = result[MAXSAT_OPTION].as<Int>(); // global var
+    if (maxsatSolving && (weightedCounting || projectedCounting)) {
+      throw MyError("MaxSAT excludes weighted and projected counting");
+    }
+
+    verboseCnf = result[VERBOSE_CNF_OPTION].as<Int>(); // global var
+    verboseSolving = result[VERBOSE_SOLVING_OPTION].as<Int>(); // global var
+
+    toolStartPoint = util::getTimePoint(); // global var
+    runCommand();
+    util::printRow("seconds", util::getDuration(toolStartPoint));
+  }
+  else {
+    cout << options.help();
+  }
+}
+
+/* global functions ========================================================= */
+
+int main(int argc, char** argv) {
+  cout << std::unitbuf; // enables automatic flushing
+  OptionDict(argc, argv);
+}
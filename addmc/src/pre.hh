@@ -0,0 +1,110 @@
+#pragma once
+
+/* inclusions =============================================================== */
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+
+#include "../libraries/cxxopts/include/cxxopts.hpp"
+
+#include "logic.hh"
+
+/* uses ===================================================================== */
+
+using cxxopts::value;
+
+/* consts =================================================================== */
+
+const string OUTPUT_FILE_OPTION = "of";
+const string RECONSTRUCTION_FILE_OPTION = "rf";
+const string MODEL_FILE_OPTION = "mf";
+const string MAXSAT_OPTION = "mx";
+const string WEIGHTED_COUNTING_OPTION = "wc";
+
+const Int WORD_BITS = 64;
+
+const Int ELIM_MAX_RESOLVENT_PAIRS = 256; // per var
+const Int ELIM_MAX_RESOLVENT_SIZE = 20;
+
+/* classes ================================================================== */
+
+class XorSystem { // hard XOR constraints as GF(2) rows, bit-packed so rows are added word by word
+public:
+  vector<Int> columnVars; // column |-> var
+  Map<Int, Int> varColumns; // var |-> column
+  Int wordCount = 0;
+  vector<vector<uint64_t>> rows; // row |-> column bits
+  vector<bool> parities; // row |-> right-hand side: XOR of row vars
+  vector<Int> pivotColumns; // row |-> pivot column, or MIN_INT for zero row
+  bool consistent = true;
+
+  bool getBit(Int row, Int column) const;
+  void addRow(Int targetRow, Int sourceRow); // target += source over GF(2)
+  Int choosePivotColumn(Int row, const Set<Int>& sharedVars) const; // prefers vars outside other constraints
+  void eliminate(const Set<Int>& sharedVars); // Gauss-Jordan: each pivot var remains in its own row only
+  Int getRank() const;
+  Clause getXorClause(Int row) const; // literals whose XOR is true iff row holds
+
+  XorSystem(const vector<Clause>& xorClauses); // a clause is satisfied iff an odd number of its literals are true
+};
+
+class Preprocessor {
+public:
+  Cnf cnf; // constraints are simplified in place
+  vector<bool> removedClauses; // clause index |-> not written
+  Map<Int, Set<Int>> varClauses; // var |-> indices of unremoved constraints
+  Assignment fixedVals; // by hard units
+  vector<pair<char, vector<Int>>> reconstructionSteps; // ('r', witness then clause) or ('x', pivot var then XOR), in elimination order
+  Int costOffset = 0; // of soft constraints falsified by fixed vals
+  bool consistent = true;
+
+  Int fixedVarCount = 0;
+  Int mergedClauseCount = 0;
+  Int subsumedClauseCount = 0;
+  Int strengthenedClauseCount = 0;
+  Int eliminatedVarCount = 0;
+  Int hardXorCount = 0;
+  Int xorRank = 0;
+  Int droppedXorCount = 0; // rows whose pivot var occurs nowhere else
+
+  bool isHard(Int clauseIndex) const;
+  void addClause(const Clause& clause, char type, double weight);
+  void removeClause(Int clauseIndex);
+  void removeLiteral(Int clauseIndex, Int literal);
+  void falsifyClause(Int clauseIndex); // soft cost goes to offset
+  void simplifyClause(Int clauseIndex, vector<Int>& unitQueue); // under fixed vals
+  void propagateUnits(vector<Int> unitQueue = {}); // literals, plus those of hard unit clauses
+  void mergeDuplicates(); // soft duplicates add up weights
+  static Int getSubsumption(const Clause& subsumer, const Clause& clause); // 0: subsumes; subsumer literal: subsumes once literal is flipped; MIN_INT: neither
+  void subsumeClauses(vector<Int>& unitQueue); // by hard clauses
+  bool isHardOnlyVar(Int var) const;
+  void eliminateVars(); // bounded var elimination, so clause count does not grow
+  void reduceXors();
+  static string getWeightWord(double weight);
+  void writeConstraint(ostream& os, const Clause& clause, char type, double weight, Int comparator, const Map<Int, Int>& coefs, Int k) const;
+  void writeFormula(string filePath) const; // hwcnf, readable by lg and dmc
+  void writeReconstruction(string filePath) const;
+  void printStats() const;
+
+  static void printReconstructedModel(string reconstructionFilePath, string modelFilePath); // extends "v" line of reduced formula to original formula
+
+  Preprocessor(string cnfFilePath);
+};
+
+class OptionDict {
+public:
+  string cnfFilePath;
+  string outputFilePath;
+  string reconstructionFilePath;
+  string modelFilePath;
+
+  void runCommand() const;
+
+  OptionDict(int argc, char** argv);
+};
+
+/* global functions ========================================================= */
+
+int main(int argc, char** argv);